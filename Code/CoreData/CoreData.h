@@ -11,4 +11,5 @@
 #import "RKManagedObject.h"
 #import "RKManagedObjectStore.h"
 #import "RKObjectSeeder.h"
-#import "RKManagedObjectCache.h"
\ No newline at end of file
+#import "RKManagedObjectCache.h"
+#import "RKManagedObjectIdentityMap.h"
\ No newline at end of file
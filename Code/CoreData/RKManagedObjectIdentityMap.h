@@ -0,0 +1,92 @@
+//
+//  RKManagedObjectIdentityMap.h
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import <CoreData/CoreData.h>
+
+/**
+ * A bounded map from the primary key values of one entity to the NSManagedObjectIDs of
+ * the corresponding objects. Object IDs are valid in every managed object context, so a
+ * single map is shared by all threads.
+ *
+ * When the map is full, entries are evicted with the CLOCK algorithm: each lookup marks
+ * its entry as referenced and eviction sweeps past referenced entries, clearing their mark,
+ * until it finds one that has not been used since the last sweep.
+ */
+@interface RKManagedObjectIdentityMap : NSObject {
+	NSLock* _lock;
+	NSUInteger _capacity;
+	NSUInteger _count;
+	NSUInteger _hand;
+	id* _keys;
+	NSManagedObjectID** _objectIDs;
+	BOOL* _referenced;
+	NSUInteger* _freeSlots;
+	NSUInteger _freeCount;
+	CFMutableDictionaryRef _slotsByKey;
+	NSUInteger _hits;
+	NSUInteger _misses;
+	NSUInteger _evictions;
+}
+
+/**
+ * The maximum number of object IDs held by the map
+ */
+@property (nonatomic, readonly) NSUInteger capacity;
+
+/**
+ * The number of object IDs currently held by the map
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ * The number of lookups that found an object ID
+ */
+@property (nonatomic, readonly) NSUInteger hits;
+
+/**
+ * The number of lookups that did not find an object ID
+ */
+@property (nonatomic, readonly) NSUInteger misses;
+
+/**
+ * The number of object IDs evicted to make room for new ones
+ */
+@property (nonatomic, readonly) NSUInteger evictions;
+
+/**
+ * Initialize an identity map holding at most capacity object IDs
+ */
+- (id)initWithCapacity:(NSUInteger)capacity;
+
+/**
+ * Returns the object ID for a primary key value, or nil when it is not in the map
+ */
+- (NSManagedObjectID*)objectIDForPrimaryKeyValue:(id)primaryKeyValue;
+
+/**
+ * Adds the object ID for a primary key value, evicting another entry if the map is full.
+ * Temporary object IDs are ignored as they are only meaningful to the context that created them
+ */
+- (void)setObjectID:(NSManagedObjectID*)objectID forPrimaryKeyValue:(id)primaryKeyValue;
+
+/**
+ * Removes the object ID for a primary key value
+ */
+- (void)removeObjectIDForPrimaryKeyValue:(id)primaryKeyValue;
+
+/**
+ * Removes every object ID. Statistics are preserved
+ */
+- (void)removeAllObjectIDs;
+
+/**
+ * Resets the hit, miss and eviction counters
+ */
+- (void)resetStatistics;
+
+@end
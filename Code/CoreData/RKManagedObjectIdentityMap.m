@@ -0,0 +1,200 @@
+//
+//  RKManagedObjectIdentityMap.m
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import "RKManagedObjectIdentityMap.h"
+
+@interface RKManagedObjectIdentityMap (Private)
+- (BOOL)getSlot:(NSUInteger*)slot forPrimaryKeyValue:(id)primaryKeyValue;
+- (void)removeObjectIDAtSlot:(NSUInteger)slot;
+- (NSUInteger)evictObjectID;
+@end
+
+@implementation RKManagedObjectIdentityMap
+
+@synthesize capacity = _capacity;
+
+- (id)initWithCapacity:(NSUInteger)capacity {
+	if ((self = [self init])) {
+		_lock = [[NSLock alloc] init];
+		_capacity = MAX(capacity, 1);
+		_keys = calloc(_capacity, sizeof(id));
+		_objectIDs = calloc(_capacity, sizeof(NSManagedObjectID*));
+		_referenced = calloc(_capacity, sizeof(BOOL));
+		_freeSlots = calloc(_capacity, sizeof(NSUInteger));
+		// Slot indexes are stored offset by one so that no value is NULL
+		_slotsByKey = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
+
+		NSUInteger i;
+		for (i = 0; i < _capacity; i++) {
+			_freeSlots[i] = _capacity - i - 1;
+		}
+		_freeCount = _capacity;
+	}
+
+	return self;
+}
+
+- (void)dealloc {
+	[self removeAllObjectIDs];
+	CFRelease(_slotsByKey);
+	free(_keys);
+	free(_objectIDs);
+	free(_referenced);
+	free(_freeSlots);
+	[_lock release];
+	[super dealloc];
+}
+
+- (NSUInteger)count {
+	[_lock lock];
+	NSUInteger count = _count;
+	[_lock unlock];
+	return count;
+}
+
+- (NSUInteger)hits {
+	[_lock lock];
+	NSUInteger hits = _hits;
+	[_lock unlock];
+	return hits;
+}
+
+- (NSUInteger)misses {
+	[_lock lock];
+	NSUInteger misses = _misses;
+	[_lock unlock];
+	return misses;
+}
+
+- (NSUInteger)evictions {
+	[_lock lock];
+	NSUInteger evictions = _evictions;
+	[_lock unlock];
+	return evictions;
+}
+
+- (BOOL)getSlot:(NSUInteger*)slot forPrimaryKeyValue:(id)primaryKeyValue {
+	const void* value = NULL;
+	if (CFDictionaryGetValueIfPresent(_slotsByKey, primaryKeyValue, &value)) {
+		*slot = (NSUInteger)value - 1;
+		return YES;
+	}
+
+	return NO;
+}
+
+- (void)removeObjectIDAtSlot:(NSUInteger)slot {
+	CFDictionaryRemoveValue(_slotsByKey, _keys[slot]);
+	[_keys[slot] release];
+	[_objectIDs[slot] release];
+	_keys[slot] = nil;
+	_objectIDs[slot] = nil;
+	_referenced[slot] = NO;
+	_freeSlots[_freeCount++] = slot;
+	_count--;
+}
+
+// Advances the clock hand past recently referenced entries and evicts the first one that is not
+- (NSUInteger)evictObjectID {
+	while (_referenced[_hand]) {
+		_referenced[_hand] = NO;
+		_hand = (_hand + 1) % _capacity;
+	}
+
+	NSUInteger slot = _hand;
+	_hand = (_hand + 1) % _capacity;
+	[self removeObjectIDAtSlot:slot];
+	_evictions++;
+	return _freeSlots[--_freeCount];
+}
+
+- (NSManagedObjectID*)objectIDForPrimaryKeyValue:(id)primaryKeyValue {
+	if (nil == primaryKeyValue) {
+		return nil;
+	}
+
+	NSManagedObjectID* objectID = nil;
+	NSUInteger slot;
+	[_lock lock];
+	if ([self getSlot:&slot forPrimaryKeyValue:primaryKeyValue]) {
+		_referenced[slot] = YES;
+		objectID = [[_objectIDs[slot] retain] autorelease];
+		_hits++;
+	} else {
+		_misses++;
+	}
+	[_lock unlock];
+
+	return objectID;
+}
+
+- (void)setObjectID:(NSManagedObjectID*)objectID forPrimaryKeyValue:(id)primaryKeyValue {
+	if (nil == primaryKeyValue || nil == objectID || [objectID isTemporaryID]) {
+		return;
+	}
+
+	NSUInteger slot;
+	[_lock lock];
+	if ([self getSlot:&slot forPrimaryKeyValue:primaryKeyValue]) {
+		[objectID retain];
+		[_objectIDs[slot] release];
+		_objectIDs[slot] = objectID;
+	} else {
+		slot = (_freeCount > 0) ? _freeSlots[--_freeCount] : [self evictObjectID];
+		_keys[slot] = [primaryKeyValue retain];
+		_objectIDs[slot] = [objectID retain];
+		CFDictionarySetValue(_slotsByKey, primaryKeyValue, (const void*)(slot + 1));
+		_count++;
+	}
+	_referenced[slot] = YES;
+	[_lock unlock];
+}
+
+- (void)removeObjectIDForPrimaryKeyValue:(id)primaryKeyValue {
+	if (nil == primaryKeyValue) {
+		return;
+	}
+
+	NSUInteger slot;
+	[_lock lock];
+	if ([self getSlot:&slot forPrimaryKeyValue:primaryKeyValue]) {
+		[self removeObjectIDAtSlot:slot];
+	}
+	[_lock unlock];
+}
+
+- (void)removeAllObjectIDs {
+	[_lock lock];
+	NSUInteger slot;
+	for (slot = 0; slot < _capacity; slot++) {
+		if (_keys[slot]) {
+			[self removeObjectIDAtSlot:slot];
+		}
+	}
+	_hand = 0;
+	[_lock unlock];
+}
+
+- (void)resetStatistics {
+	[_lock lock];
+	_hits = 0;
+	_misses = 0;
+	_evictions = 0;
+	[_lock unlock];
+}
+
+- (NSString*)description {
+	[_lock lock];
+	NSString* description = [NSString stringWithFormat:@"<%@: %lu of %lu object IDs, %lu hits, %lu misses, %lu evictions>",
+							 NSStringFromClass([self class]), (unsigned long)_count, (unsigned long)_capacity,
+							 (unsigned long)_hits, (unsigned long)_misses, (unsigned long)_evictions];
+	[_lock unlock];
+	return description;
+}
+
+@end
@@ -9,6 +9,7 @@
 #import <CoreData/CoreData.h>
 #import "RKManagedObject.h"
 #import "RKManagedObjectCache.h"
+#import "RKManagedObjectIdentityMap.h"
 
 /**
  * Notifications
@@ -22,6 +23,10 @@ extern NSString* const RKManagedObjectStoreDidFailSaveNotification;
     NSManagedObjectModel* _managedObjectModel;
 	NSPersistentStoreCoordinator* _persistentStoreCoordinator;
 	NSObject<RKManagedObjectCache>* _managedObjectCache;
+	NSMutableDictionary* _identityMaps;
+	NSUInteger _identityMapCapacity;
+	NSMutableDictionary* _contentFingerprints;
+	BOOL _hasUnsavedContentFingerprints;
 }
 
 @property (nonatomic, readonly) NSString* storeFilename;
@@ -29,6 +34,14 @@ extern NSString* const RKManagedObjectStoreDidFailSaveNotification;
 @property (nonatomic, readonly) NSPersistentStoreCoordinator* persistentStoreCoordinator;
 @property (nonatomic, retain) NSObject<RKManagedObjectCache>* managedObjectCache;
 
+/**
+ * The maximum number of primary keys remembered for each managed object class. Applies
+ * to identity maps created after it is set
+ *
+ * @default 5000
+ */
+@property (nonatomic, assign) NSUInteger identityMapCapacity;
+
 /*
  * This returns an appropriate managed object context for this object store.
  * Because of the intrecacies of how CoreData works across threads it returns
@@ -46,6 +59,19 @@ extern NSString* const RKManagedObjectStoreDidFailSaveNotification;
  */
 - (NSError*)save;
 
+/**
+ * The time the last save on the calling thread spent waiting for its changes to be merged into
+ * the managed object context of the main thread, or 0 when it saved no changes. Saves made on
+ * other threads are not included
+ */
+- (NSTimeInterval)mergeDurationOfLastSave;
+
+/**
+ * Discards the objects registered with the managed object context of the calling thread, along
+ * with the unsaved objects and missing primary keys it remembers for findInstancesOfManagedObject:
+ */
+- (void)resetManagedObjectContext;
+
 /**
  * This deletes and recreates the managed object context and 
  * persistant store, effectively clearing all data
@@ -71,5 +97,56 @@ extern NSString* const RKManagedObjectStoreDidFailSaveNotification;
  */
 - (RKManagedObject*)findOrCreateInstanceOfManagedObject:(Class)class withPrimaryKeyValue:(id)primaryKeyValue;
 
+/**
+ * Fetches the instances of a managed object class having any of the given primary key values,
+ * using a single IN query per batch of keys rather than one query per key. The object IDs
+ * found are remembered in the identity map of the class and the keys that do not exist yet are
+ * remembered by the current thread until its context is saved, so a subsequent
+ * findOrCreateInstanceOfManagedObject:withPrimaryKeyValue: for any of the keys needs no fetch.
+ *
+ * Returns a dictionary of the objects found, keyed by primary key value
+ */
+- (NSDictionary*)findInstancesOfManagedObject:(Class)class withPrimaryKeyValues:(NSArray*)primaryKeyValues;
+
+/**
+ * Returns the identity map shared by all threads that remembers the object IDs of the
+ * managed objects of a class by primary key. Useful for inspecting its hit rate
+ */
+- (RKManagedObjectIdentityMap*)identityMapForManagedObject:(Class)class;
+
+/**
+ * Returns the fingerprint of the payload last mapped into the store for a resource path, or nil.
+ * Fingerprints are persisted next to the store and are discarded with it
+ */
+- (NSString*)contentFingerprintForResourcePath:(NSString*)resourcePath;
+
+/**
+ * Returns the object IDs of the objects the payload with the fingerprint was last mapped to for a
+ * resource path, in payload order. Returns nil when a different payload was mapped last, or when
+ * any of the objects has been deleted since
+ */
+- (NSArray*)objectIDsForContentFingerprint:(NSString*)fingerprint resourcePath:(NSString*)resourcePath;
+
+/**
+ * Remembers the fingerprint of the payload mapped into the store for a resource path, together
+ * with the permanent object IDs of the objects it was mapped to. Passing a nil fingerprint
+ * forgets the resource path.
+ *
+ * Fingerprints are written to disk a couple of seconds after they change, so the writes of
+ * loads finishing together are batched, and when the application enters the background
+ */
+- (void)setContentFingerprint:(NSString*)fingerprint objectIDs:(NSArray*)objectIDs forResourcePath:(NSString*)resourcePath;
+
+/**
+ * Writes fingerprints that have changed to disk straight away
+ */
+- (void)saveContentFingerprints;
+
+/**
+ * Forgets every fingerprint, forcing the next payload for each resource path to be mapped.
+ * Call this after changing objects that are loaded from the managed object cache outside of
+ * an object loader
+ */
+- (void)removeAllContentFingerprints;
 
 @end
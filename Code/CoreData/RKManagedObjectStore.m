@@ -11,11 +11,24 @@
 
 NSString* const RKManagedObjectStoreDidFailSaveNotification = @"RKManagedObjectStoreDidFailSaveNotification";
 static NSString* const kRKManagedObjectContextKey = @"RKManagedObjectContext";
+static NSString* const kRKManagedObjectStorePendingObjectsKey = @"RKManagedObjectStorePendingObjects";
+static NSString* const kRKManagedObjectStoreMergeDurationKey = @"RKManagedObjectStoreMergeDuration";
+static const NSUInteger kRKManagedObjectStoreDefaultIdentityMapCapacity = 5000;
+static NSString* const kRKManagedObjectStoreContentFingerprintKey = @"fingerprint";
+static NSString* const kRKManagedObjectStoreContentObjectIDsKey = @"objectIDs";
+static const NSTimeInterval kRKManagedObjectStoreContentFingerprintsSaveDelay = 2.0;
+
+// Keeps the IN predicates of batched primary key fetches well below SQLite's limit on bound variables
+static const NSUInteger kRKManagedObjectStorePrimaryKeyFetchBatchSize = 500;
 
 @interface RKManagedObjectStore (Private)
 - (void)createPersistentStoreCoordinator;
 - (NSString *)applicationDocumentsDirectory;
 - (NSManagedObjectContext*)newManagedObjectContext;
+- (NSMutableDictionary*)pendingObjectsForManagedObject:(Class)class;
+- (id)primaryKeyValue:(id)primaryKeyValue forManagedObject:(Class)class;
+- (NSString*)contentFingerprintsPath;
+- (void)scheduleContentFingerprintsSave;
 @end
 
 @implementation RKManagedObjectStore
@@ -24,10 +37,26 @@ static NSString* const kRKManagedObjectContextKey = @"RKManagedObjectContext";
 @synthesize managedObjectModel = _managedObjectModel;
 @synthesize persistentStoreCoordinator = _persistentStoreCoordinator;
 @synthesize managedObjectCache = _managedObjectCache;
+@synthesize identityMapCapacity = _identityMapCapacity;
 
 - (id)initWithStoreFilename:(NSString*)storeFilename {
 	if (self = [self init]) {
 		_storeFilename = [storeFilename retain];
+		_identityMaps = [[NSMutableDictionary alloc] init];
+		_identityMapCapacity = kRKManagedObjectStoreDefaultIdentityMapCapacity;
+		_contentFingerprints = [[NSMutableDictionary alloc] initWithContentsOfFile:[self contentFingerprintsPath]];
+		if (nil == _contentFingerprints) {
+			_contentFingerprints = [[NSMutableDictionary alloc] init];
+		}
+		_hasUnsavedContentFingerprints = NO;
+		[[NSNotificationCenter defaultCenter] addObserver:self
+												 selector:@selector(saveContentFingerprints)
+													 name:UIApplicationDidEnterBackgroundNotification
+												   object:nil];
+		[[NSNotificationCenter defaultCenter] addObserver:self
+												 selector:@selector(saveContentFingerprints)
+													 name:UIApplicationWillTerminateNotification
+												   object:nil];
 		_managedObjectModel = [[NSManagedObjectModel mergedModelFromBundles:nil] retain];		
 		[self createPersistentStoreCoordinator];
 	}
@@ -45,6 +74,10 @@ static NSString* const kRKManagedObjectContextKey = @"RKManagedObjectContext";
 	_persistentStoreCoordinator = nil;
 	[_managedObjectCache release];
 	_managedObjectCache = nil;
+	[_identityMaps release];
+	_identityMaps = nil;
+	[_contentFingerprints release];
+	_contentFingerprints = nil;
 	[super dealloc];
 }
 
@@ -54,6 +87,7 @@ static NSString* const kRKManagedObjectContextKey = @"RKManagedObjectContext";
  */
 - (NSError*)save {
     NSError *error = nil;
+	[[[NSThread currentThread] threadDictionary] removeObjectForKey:kRKManagedObjectStoreMergeDurationKey];
 	@try {
 		[[self managedObjectContext] save:&error];
 	}
@@ -149,6 +183,11 @@ static NSString* const kRKManagedObjectContextKey = @"RKManagedObjectContext";
 	// Clear the current managed object context. Will be re-created next time it is accessed.
 	NSMutableDictionary* threadDictionary = [[NSThread currentThread] threadDictionary];
 	[threadDictionary setObject:nil forKey:kRKManagedObjectContextKey];
+	[threadDictionary removeObjectForKey:kRKManagedObjectStorePendingObjectsKey];
+	@synchronized(_identityMaps) {
+		[_identityMaps removeAllObjects];
+	}
+	[self removeAllContentFingerprints];
 	
 	[self createPersistentStoreCoordinator];
 }
@@ -174,6 +213,11 @@ static NSString* const kRKManagedObjectContextKey = @"RKManagedObjectContext";
 	return backgroundThreadContext;
 }
 
+- (void)resetManagedObjectContext {
+	[[self managedObjectContext] reset];
+	[[[NSThread currentThread] threadDictionary] removeObjectForKey:kRKManagedObjectStorePendingObjectsKey];
+}
+
 - (void)mergeChangesOnMainThreadWithNotification:(NSNotification*)notification {
 	assert([NSThread isMainThread]);
 	[self.managedObjectContext performSelectorOnMainThread:@selector(mergeChangesFromContextDidSaveNotification:)
@@ -182,14 +226,46 @@ static NSString* const kRKManagedObjectContextKey = @"RKManagedObjectContext";
 }
 
 - (void)mergeChanges:(NSNotification *)notification {
+	// Saved objects now have permanent IDs and can be shared with other threads through the
+	// identity maps, so the objects this thread was holding on to are no longer needed
+	NSDictionary* userInfo = notification.userInfo;
+	for (NSManagedObject* object in [userInfo objectForKey:NSInsertedObjectsKey]) {
+		if ([object respondsToSelector:@selector(primaryKeyProperty)]) {
+			Class class = [object class];
+			NSString* primaryKey = [class performSelector:@selector(primaryKeyProperty)];
+			id primaryKeyValue = [object valueForKey:primaryKey];
+			[[self identityMapForManagedObject:class] setObjectID:[object objectID] forPrimaryKeyValue:primaryKeyValue];
+		}
+	}
+	
+	// Deletes are forgotten as they happen, but another thread may have remembered the key
+	// again between the delete and the save
+	for (NSManagedObject* object in [userInfo objectForKey:NSDeletedObjectsKey]) {
+		if ([object respondsToSelector:@selector(primaryKeyProperty)]) {
+			Class class = [object class];
+			NSString* primaryKey = [class performSelector:@selector(primaryKeyProperty)];
+			id primaryKeyValue = [object valueForKey:primaryKey];
+			[[self identityMapForManagedObject:class] removeObjectIDForPrimaryKeyValue:primaryKeyValue];
+		}
+	}
+	[[[NSThread currentThread] threadDictionary] removeObjectForKey:kRKManagedObjectStorePendingObjectsKey];
+	
 	// Merge changes into the main context on the main thread
+	NSTimeInterval mergeStartTime = [NSDate timeIntervalSinceReferenceDate];
 	[self performSelectorOnMainThread:@selector(mergeChangesOnMainThreadWithNotification:) withObject:notification waitUntilDone:YES];
+	NSNumber* mergeDuration = [NSNumber numberWithDouble:[NSDate timeIntervalSinceReferenceDate] - mergeStartTime];
+	[[[NSThread currentThread] threadDictionary] setObject:mergeDuration forKey:kRKManagedObjectStoreMergeDurationKey];
+}
+
+- (NSTimeInterval)mergeDurationOfLastSave {
+	return [[[[NSThread currentThread] threadDictionary] objectForKey:kRKManagedObjectStoreMergeDurationKey] doubleValue];
 }
 
 - (void)objectsDidChange:(NSNotification*)notification {
 	NSDictionary* userInfo = notification.userInfo;
 	NSSet* insertedObjects = [userInfo objectForKey:NSInsertedObjectsKey];
-	NSMutableDictionary* threadDictionary = [[NSThread currentThread] threadDictionary];
+	NSSet* deletedObjects = [userInfo objectForKey:NSDeletedObjectsKey];
+	NSMutableDictionary* pendingObjects = [[[NSThread currentThread] threadDictionary] objectForKey:kRKManagedObjectStorePendingObjectsKey];
 	
 	for (NSManagedObject* object in insertedObjects) {
 		if ([object respondsToSelector:@selector(primaryKeyProperty)]) {
@@ -197,12 +273,34 @@ static NSString* const kRKManagedObjectContextKey = @"RKManagedObjectContext";
 			NSString* primaryKey = [class performSelector:@selector(primaryKeyProperty)];
 			id primaryKeyValue = [object valueForKey:primaryKey];
 			
-			NSMutableDictionary* classCache = [threadDictionary objectForKey:class];
-			if (classCache && primaryKeyValue && [classCache objectForKey:primaryKeyValue] == nil) {
+			NSMutableDictionary* classCache = [pendingObjects objectForKey:class];
+			id cachedObject = [classCache objectForKey:primaryKeyValue];
+			if (classCache && primaryKeyValue && (cachedObject == nil || cachedObject == [NSNull null])) {
 				[classCache setObject:object forKey:primaryKeyValue];
 			}
 		}
 	}
+	
+	for (NSManagedObject* object in deletedObjects) {
+		if ([object respondsToSelector:@selector(primaryKeyProperty)]) {
+			Class class = [object class];
+			NSString* primaryKey = [class performSelector:@selector(primaryKeyProperty)];
+			id primaryKeyValue = [object valueForKey:primaryKey];
+			if (primaryKeyValue) {
+				[[self identityMapForManagedObject:class] removeObjectIDForPrimaryKeyValue:primaryKeyValue];
+				[[pendingObjects objectForKey:class] removeObjectForKey:primaryKeyValue];
+			}
+		}
+	}
+	
+	if ([userInfo objectForKey:NSInvalidatedAllObjectsKey]) {
+		@synchronized(_identityMaps) {
+			for (Class class in _identityMaps) {
+				[[_identityMaps objectForKey:class] removeAllObjectIDs];
+			}
+		}
+		[pendingObjects removeAllObjects];
+	}
 }
 
 #pragma mark -
@@ -232,35 +330,280 @@ static NSString* const kRKManagedObjectContextKey = @"RKManagedObjectContext";
 	return objectArray;
 }
 
-- (RKManagedObject*)findOrCreateInstanceOfManagedObject:(Class)class withPrimaryKeyValue:(id)primaryKeyValue {
-	RKManagedObject* object = nil;
-	if ([class respondsToSelector:@selector(allObjects)]) {
-		NSArray* objects = nil;
-		NSMutableDictionary* threadDictionary = [[NSThread currentThread] threadDictionary];
+- (RKManagedObjectIdentityMap*)identityMapForManagedObject:(Class)class {
+	RKManagedObjectIdentityMap* identityMap = nil;
+	@synchronized(_identityMaps) {
+		identityMap = [_identityMaps objectForKey:class];
+		if (nil == identityMap) {
+			identityMap = [[RKManagedObjectIdentityMap alloc] initWithCapacity:_identityMapCapacity];
+			[_identityMaps setObject:identityMap forKey:class];
+			[identityMap release];
+		}
+	}
+	
+	return identityMap;
+}
+
+- (NSString*)contentFingerprintsPath {
+	NSString* fileName = [_storeFilename stringByAppendingPathExtension:@"fingerprints.plist"];
+	return [[self applicationDocumentsDirectory] stringByAppendingPathComponent:fileName];
+}
+
+// Each resource path maps to its fingerprint and the URI representations of the mapped object IDs.
+// Entries written in other formats are ignored
+- (NSString*)contentFingerprintForResourcePath:(NSString*)resourcePath {
+	@synchronized(_contentFingerprints) {
+		NSDictionary* entry = [_contentFingerprints objectForKey:resourcePath];
+		if (NO == [entry isKindOfClass:[NSDictionary class]]) {
+			return nil;
+		}
+
+		return [[[entry objectForKey:kRKManagedObjectStoreContentFingerprintKey] retain] autorelease];
+	}
+}
+
+- (NSArray*)objectIDsForContentFingerprint:(NSString*)fingerprint resourcePath:(NSString*)resourcePath {
+	NSArray* URIs = nil;
+	@synchronized(_contentFingerprints) {
+		NSDictionary* entry = [_contentFingerprints objectForKey:resourcePath];
+		if (NO == [entry isKindOfClass:[NSDictionary class]] ||
+			NO == [[entry objectForKey:kRKManagedObjectStoreContentFingerprintKey] isEqualToString:fingerprint]) {
+			return nil;
+		}
+		URIs = [[[entry objectForKey:kRKManagedObjectStoreContentObjectIDsKey] retain] autorelease];
+	}
+
+	NSMutableArray* objectIDs = [NSMutableArray arrayWithCapacity:[URIs count]];
+	NSMutableDictionary* objectIDsByEntityName = [NSMutableDictionary dictionary];
+	for (NSString* URI in URIs) {
+		NSManagedObjectID* objectID = [_persistentStoreCoordinator managedObjectIDForURIRepresentation:[NSURL URLWithString:URI]];
+		if (nil == objectID) {
+			return nil;
+		}
+
+		[objectIDs addObject:objectID];
+		NSMutableSet* entityObjectIDs = [objectIDsByEntityName objectForKey:[[objectID entity] name]];
+		if (nil == entityObjectIDs) {
+			entityObjectIDs = [NSMutableSet set];
+			[objectIDsByEntityName setObject:entityObjectIDs forKey:[[objectID entity] name]];
+		}
+		[entityObjectIDs addObject:objectID];
+	}
+
+	// The objects may have been deleted since the payload was mapped, in which case it must be mapped again
+	NSManagedObjectContext* context = [self managedObjectContext];
+	for (NSString* entityName in objectIDsByEntityName) {
+		NSSet* entityObjectIDs = [objectIDsByEntityName objectForKey:entityName];
+		NSFetchRequest* fetchRequest = [[[NSFetchRequest alloc] init] autorelease];
+		[fetchRequest setEntity:[[entityObjectIDs anyObject] entity]];
+		[fetchRequest setPredicate:[NSPredicate predicateWithFormat:@"SELF IN %@", entityObjectIDs]];
+		if ([context countForFetchRequest:fetchRequest error:nil] != [entityObjectIDs count]) {
+			return nil;
+		}
+	}
+
+	return objectIDs;
+}
+
+- (void)setContentFingerprint:(NSString*)fingerprint objectIDs:(NSArray*)objectIDs forResourcePath:(NSString*)resourcePath {
+	if (nil == resourcePath) {
+		return;
+	}
+
+	NSMutableArray* URIs = [NSMutableArray arrayWithCapacity:[objectIDs count]];
+	for (NSManagedObjectID* objectID in objectIDs) {
+		if ([objectID isTemporaryID]) {
+			// Temporary IDs do not outlive the context, so the payload could not be looked up again
+			fingerprint = nil;
+			break;
+		}
+		[URIs addObject:[[objectID URIRepresentation] absoluteString]];
+	}
+
+	BOOL needsScheduling = NO;
+	@synchronized(_contentFingerprints) {
+		if (fingerprint) {
+			NSDictionary* entry = [NSDictionary dictionaryWithObjectsAndKeys:fingerprint, kRKManagedObjectStoreContentFingerprintKey,
+								   URIs, kRKManagedObjectStoreContentObjectIDsKey, nil];
+			[_contentFingerprints setObject:entry forKey:resourcePath];
+		} else if ([_contentFingerprints objectForKey:resourcePath]) {
+			[_contentFingerprints removeObjectForKey:resourcePath];
+		} else {
+			return;
+		}
+		needsScheduling = (NO == _hasUnsavedContentFingerprints);
+		_hasUnsavedContentFingerprints = YES;
+	}
+
+	if (needsScheduling) {
+		[self performSelectorOnMainThread:@selector(scheduleContentFingerprintsSave) withObject:nil waitUntilDone:NO];
+	}
+}
+
+- (void)scheduleContentFingerprintsSave {
+	[self performSelector:@selector(saveContentFingerprints) withObject:nil afterDelay:kRKManagedObjectStoreContentFingerprintsSaveDelay];
+}
+
+- (void)saveContentFingerprints {
+	@synchronized(_contentFingerprints) {
+		if (_hasUnsavedContentFingerprints) {
+			[_contentFingerprints writeToFile:[self contentFingerprintsPath] atomically:YES];
+			_hasUnsavedContentFingerprints = NO;
+		}
+	}
+}
+
+- (void)removeAllContentFingerprints {
+	@synchronized(_contentFingerprints) {
+		[_contentFingerprints removeAllObjects];
+		[[NSFileManager defaultManager] removeItemAtPath:[self contentFingerprintsPath] error:nil];
+		_hasUnsavedContentFingerprints = NO;
+	}
+}
+
+// Objects created by the current thread that have not been saved yet and so have no permanent
+// object ID to share. Keys confirmed not to exist in the store map to NSNull so they are not
+// fetched again. Cleared whenever the context of the thread is saved
+- (NSMutableDictionary*)pendingObjectsForManagedObject:(Class)class {
+	NSMutableDictionary* threadDictionary = [[NSThread currentThread] threadDictionary];
+	NSMutableDictionary* pendingObjects = [threadDictionary objectForKey:kRKManagedObjectStorePendingObjectsKey];
+	if (nil == pendingObjects) {
+		pendingObjects = [NSMutableDictionary dictionary];
+		[threadDictionary setObject:pendingObjects forKey:kRKManagedObjectStorePendingObjectsKey];
+	}
+	
+	NSMutableDictionary* dictionary = [pendingObjects objectForKey:class];
+	if (nil == dictionary) {
+		dictionary = [NSMutableDictionary dictionary];
+		[pendingObjects setObject:dictionary forKey:class];
+	}
+	
+	return dictionary;
+}
+
+// Payloads frequently encode numeric keys as strings and vice versa. Coerce them to the type
+// of the primary key attribute so they compare equal to the values of fetched objects
+- (id)primaryKeyValue:(id)primaryKeyValue forManagedObject:(Class)class {
+	NSString* primaryKey = [class performSelector:@selector(primaryKeyProperty)];
+	NSAttributeDescription* attribute = [[[class entity] attributesByName] objectForKey:primaryKey];
+	switch ([attribute attributeType]) {
+		case NSInteger16AttributeType:
+		case NSInteger32AttributeType:
+		case NSInteger64AttributeType:
+			if ([primaryKeyValue isKindOfClass:[NSString class]]) {
+				return [NSNumber numberWithLongLong:[(NSString*)primaryKeyValue longLongValue]];
+			}
+			break;
+		case NSStringAttributeType:
+			if ([primaryKeyValue isKindOfClass:[NSNumber class]]) {
+				return [(NSNumber*)primaryKeyValue stringValue];
+			}
+			break;
+		default:
+			break;
+	}
+	
+	return primaryKeyValue;
+}
+
+- (NSDictionary*)findInstancesOfManagedObject:(Class)class withPrimaryKeyValues:(NSArray*)primaryKeyValues {
+	NSMutableDictionary* objects = [NSMutableDictionary dictionary];
+	if (NO == [class respondsToSelector:@selector(allObjects)]) {
+		return objects;
+	}
+	
+	NSMutableDictionary* pendingObjects = [self pendingObjectsForManagedObject:class];
+	RKManagedObjectIdentityMap* identityMap = [self identityMapForManagedObject:class];
+	NSManagedObjectContext* managedObjectContext = self.managedObjectContext;
+	NSMutableSet* unresolvedPrimaryKeyValues = [NSMutableSet set];
+	NSMutableDictionary* primaryKeyValuesByObjectID = [NSMutableDictionary dictionary];
+	for (id primaryKeyValue in primaryKeyValues) {
+		primaryKeyValue = [self primaryKeyValue:primaryKeyValue forManagedObject:class];
+		id object = [pendingObjects objectForKey:primaryKeyValue];
+		if (nil == object) {
+			NSManagedObjectID* objectID = [identityMap objectIDForPrimaryKeyValue:primaryKeyValue];
+			if (objectID) {
+				object = [managedObjectContext objectRegisteredForID:objectID];
+				if (nil == object) {
+					[primaryKeyValuesByObjectID setObject:primaryKeyValue forKey:objectID];
+					continue;
+				}
+			}
+		}
 		
-		if (nil == [threadDictionary objectForKey:class]) {
+		if (nil == object) {
+			[unresolvedPrimaryKeyValues addObject:primaryKeyValue];
+		} else if (object != [NSNull null]) {
+			[objects setObject:object forKey:primaryKeyValue];
+		}
+	}
+	
+	// Remembered object IDs are fetched rather than faulted in: another context may have deleted
+	// the object since, and firing the fault of a deleted object raises an exception
+	if ([primaryKeyValuesByObjectID count] > 0) {
+		NSArray* objectIDs = [primaryKeyValuesByObjectID allKeys];
+		NSUInteger location = 0;
+		while (location < [objectIDs count]) {
+			NSRange range = NSMakeRange(location, MIN(kRKManagedObjectStorePrimaryKeyFetchBatchSize, [objectIDs count] - location));
 			NSFetchRequest* fetchRequest = [class fetchRequest];
-			[fetchRequest setReturnsObjectsAsFaults:NO];			
-			objects = [class objectsWithFetchRequest:fetchRequest];
-			NSLog(@"Cacheing all %d %@ objects to thread local storage", [objects count], class);
-			NSMutableDictionary* dictionary = [NSMutableDictionary dictionary];
-			NSString* primaryKey = [class performSelector:@selector(primaryKeyProperty)];
-			for (id theObject in objects) {			
-				id primaryKeyValue = [theObject valueForKey:primaryKey];
+			[fetchRequest setPredicate:[NSPredicate predicateWithFormat:@"SELF IN %@", [objectIDs subarrayWithRange:range]]];
+			[fetchRequest setReturnsObjectsAsFaults:NO];
+			for (NSManagedObject* object in [class objectsWithFetchRequest:fetchRequest]) {
+				id primaryKeyValue = [primaryKeyValuesByObjectID objectForKey:[object objectID]];
 				if (primaryKeyValue) {
-					[dictionary setObject:theObject forKey:primaryKeyValue];
+					[objects setObject:object forKey:primaryKeyValue];
+					[primaryKeyValuesByObjectID removeObjectForKey:[object objectID]];
 				}
 			}
-			
-			[threadDictionary setObject:dictionary forKey:class];
+			location += range.length;
+		}
+		
+		for (NSManagedObjectID* objectID in primaryKeyValuesByObjectID) {
+			id primaryKeyValue = [primaryKeyValuesByObjectID objectForKey:objectID];
+			[identityMap removeObjectIDForPrimaryKeyValue:primaryKeyValue];
+			[unresolvedPrimaryKeyValues addObject:primaryKeyValue];
+		}
+	}
+	
+	if ([unresolvedPrimaryKeyValues count] > 0) {
+		NSString* primaryKey = [class performSelector:@selector(primaryKeyProperty)];
+		NSArray* unresolved = [unresolvedPrimaryKeyValues allObjects];
+		NSUInteger location = 0;
+		while (location < [unresolved count]) {
+			NSRange range = NSMakeRange(location, MIN(kRKManagedObjectStorePrimaryKeyFetchBatchSize, [unresolved count] - location));
+			NSArray* batch = [unresolved subarrayWithRange:range];
+			NSFetchRequest* fetchRequest = [class fetchRequest];
+			[fetchRequest setPredicate:[NSPredicate predicateWithFormat:@"%K IN %@", primaryKey, batch]];
+			[fetchRequest setReturnsObjectsAsFaults:NO];
+			for (NSManagedObject* object in [class objectsWithFetchRequest:fetchRequest]) {
+				id primaryKeyValue = [object valueForKey:primaryKey];
+				if (primaryKeyValue) {
+					[identityMap setObjectID:[object objectID] forPrimaryKeyValue:primaryKeyValue];
+					[objects setObject:object forKey:primaryKeyValue];
+					[unresolvedPrimaryKeyValues removeObject:primaryKeyValue];
+				}
+			}
+			location += range.length;
 		}
 		
-		NSMutableDictionary* dictionary = [threadDictionary objectForKey:class];
-		object = [dictionary objectForKey:primaryKeyValue];
+		for (id primaryKeyValue in unresolvedPrimaryKeyValues) {
+			[pendingObjects setObject:[NSNull null] forKey:primaryKeyValue];
+		}
+	}
+	
+	return objects;
+}
+
+- (RKManagedObject*)findOrCreateInstanceOfManagedObject:(Class)class withPrimaryKeyValue:(id)primaryKeyValue {
+	RKManagedObject* object = nil;
+	if ([class respondsToSelector:@selector(allObjects)] && primaryKeyValue) {
+		primaryKeyValue = [self primaryKeyValue:primaryKeyValue forManagedObject:class];
+		NSDictionary* objects = [self findInstancesOfManagedObject:class withPrimaryKeyValues:[NSArray arrayWithObject:primaryKeyValue]];
+		object = [objects objectForKey:primaryKeyValue];
 		
-		if (object == nil && primaryKeyValue && [class respondsToSelector:@selector(object)]) {
+		if (nil == object && [class respondsToSelector:@selector(object)]) {
 			object = [class object];
-			[dictionary setObject:object forKey:primaryKeyValue];
+			[[self pendingObjectsForManagedObject:class] setObject:object forKey:primaryKeyValue];
 		}
 	}
 	return object;
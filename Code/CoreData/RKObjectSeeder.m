@@ -48,9 +48,9 @@
 - (void)seedObjectsFromFile:(NSString*)fileName ofType:(NSString*)type toClass:(Class)theClass keyPath:(NSString*)keyPath {
 	NSError* error = nil;
 	NSString* filePath = [[NSBundle mainBundle] pathForResource:fileName ofType:type];
-	NSString* payload = [NSString stringWithContentsOfFile:filePath encoding:NSUTF8StringEncoding error:&error];
+	NSData* payload = [NSData dataWithContentsOfFile:filePath options:0 error:&error];
 	if (nil == error) {
-		id objects = [_manager.mapper parseString:payload];
+		id objects = [_manager.mapper parseData:payload];
 		NSAssert1(objects != nil, @"Unable to parse data from file %@", filePath);		
 		id parseableObjects = [objects valueForKeyPath:keyPath];
 		NSAssert1([parseableObjects isKindOfClass:[NSArray class]], @"Expected an NSArray of objects, got %@", objects);
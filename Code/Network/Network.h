@@ -12,3 +12,9 @@
 #import "RKRequestSerializable.h"
 #import "RKReachabilityObserver.h"
 #import "RKRequestQueue.h"
+#import "RKRequestCache.h"
+#import "RKRequestRetryPolicy.h"
+#import "RKRequestMetrics.h"
+#import "RKGzipInputStream.h"
+#import "RKResumableUpload.h"
+#import "RKResponseFileSink.h"
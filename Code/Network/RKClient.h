@@ -11,6 +11,8 @@
 #import "RKResponse.h"
 #import "NSDictionary+RKRequestSerialization.h"
 #import "RKReachabilityObserver.h"
+#import "RKRequestCache.h"
+#import "RKRequestRetryPolicy.h"
 
 /////////////////////////////////////////////////////////////////////////
 
@@ -62,6 +64,11 @@ NSString* RKMakePathWithObject(NSString* path, id object);
 	NSString* _serviceUnavailableAlertTitle;
 	NSString* _serviceUnavailableAlertMessage;
 	BOOL _serviceUnavailableAlertEnabled;
+	RKRequestCache* _requestCache;
+	NSUInteger _requestBodyCompressionThreshold;
+	BOOL _compressesRequestBodies;
+	RKRequestRetryPolicy* _retryPolicy;
+	NSObject<RKRequestMetricsSink>* _metricsSink;
 }
 
 /**
@@ -111,6 +118,38 @@ NSString* RKMakePathWithObject(NSString* path, id object);
  */
 @property(nonatomic, assign) BOOL serviceUnavailableAlertEnabled;
 
+/**
+ * The cache GET responses of requests created by this client are stored in and revalidated
+ * against. Repeated GETs are sent with If-None-Match and If-Modified-Since and a 304 Not Modified
+ * response is answered from the cache. Defaults to nil, which disables caching.
+ */
+@property(nonatomic, retain) RKRequestCache* requestCache;
+
+/**
+ * When YES, request bodies of at least requestBodyCompressionThreshold bytes are sent gzip
+ * compressed with a Content-Encoding: gzip header. Only enable this against servers that
+ * decompress request bodies. Defaults to NO.
+ */
+@property(nonatomic, assign) BOOL compressesRequestBodies;
+
+/**
+ * The size in bytes below which request bodies are sent uncompressed. Defaults to 1024.
+ */
+@property(nonatomic, assign) NSUInteger requestBodyCompressionThreshold;
+
+/**
+ * The policy deciding when requests created by this client are sent again after a connection
+ * failure or a transient error response. Defaults to the default RKRequestRetryPolicy, which
+ * retries GET, PUT and DELETE requests up to three times. Set to nil to send requests once.
+ */
+@property(nonatomic, retain) RKRequestRetryPolicy* retryPolicy;
+
+/**
+ * The sink the metrics of requests created by this client are delivered to once they finish.
+ * Metrics are only collected when a sink is set. Defaults to nil.
+ */
+@property(nonatomic, retain) NSObject<RKRequestMetricsSink>* metricsSink;
+
 /**
  * Return the configured singleton instance of the Rest client
  */
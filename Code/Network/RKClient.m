@@ -75,6 +75,11 @@ NSString* RKMakePathWithObject(NSString* path, id object) {
 @synthesize serviceUnavailableAlertTitle = _serviceUnavailableAlertTitle;
 @synthesize serviceUnavailableAlertMessage = _serviceUnavailableAlertMessage;
 @synthesize serviceUnavailableAlertEnabled = _serviceUnavailableAlertEnabled;
+@synthesize requestCache = _requestCache;
+@synthesize compressesRequestBodies = _compressesRequestBodies;
+@synthesize retryPolicy = _retryPolicy;
+@synthesize metricsSink = _metricsSink;
+@synthesize requestBodyCompressionThreshold = _requestBodyCompressionThreshold;
 
 + (RKClient*)sharedClient {
 	return sharedClient;
@@ -118,6 +123,9 @@ NSString* RKMakePathWithObject(NSString* path, id object) {
 	if (self = [super init]) {
 		_HTTPHeaders = [[NSMutableDictionary alloc] init];
 		self.serviceUnavailableAlertEnabled = NO;
+		self.compressesRequestBodies = NO;
+		self.requestBodyCompressionThreshold = 1024;
+		self.retryPolicy = [RKRequestRetryPolicy defaultPolicy];
 		self.serviceUnavailableAlertTitle = NSLocalizedString(@"Service Unavailable", nil);
 		self.serviceUnavailableAlertMessage = NSLocalizedString(@"The remote resource is unavailable. Please try again later.", nil);
 	}
@@ -131,6 +139,9 @@ NSString* RKMakePathWithObject(NSString* path, id object) {
 	self.password = nil;
 	self.serviceUnavailableAlertTitle = nil;
 	self.serviceUnavailableAlertMessage = nil;
+	self.requestCache = nil;
+	self.retryPolicy = nil;
+	self.metricsSink = nil;
 	[_HTTPHeaders release];
 	[super dealloc];
 }
@@ -166,6 +177,11 @@ NSString* RKMakePathWithObject(NSString* path, id object) {
 	request.additionalHTTPHeaders = _HTTPHeaders;
 	request.username = self.username;
 	request.password = self.password;
+	request.cache = self.requestCache;
+	request.compressesBody = self.compressesRequestBodies;
+	request.bodyCompressionThreshold = self.requestBodyCompressionThreshold;
+	request.retryPolicy = self.retryPolicy;
+	request.metricsSink = self.metricsSink;
 }
 
 - (void)setValue:(NSString*)value forHTTPHeaderField:(NSString*)header {
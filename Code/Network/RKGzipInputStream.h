@@ -0,0 +1,49 @@
+//
+//  RKGzipInputStream.h
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <zlib.h>
+
+/**
+ * An input stream delivering the gzip compressed bytes of another stream or of a data object.
+ * Compression happens as the stream is read, so a large body is compressed in chunks as it is
+ * uploaded instead of being copied into a second buffer. The compressed length is not known
+ * ahead of time.
+ *
+ * Applications using this class must link against libz.dylib
+ */
+@interface RKGzipInputStream : NSInputStream {
+	NSInputStream* _sourceStream;
+	NSData* _sourceData;
+	uint8_t* _sourceBuffer;
+	z_stream _zStream;
+	BOOL _isDeflating;
+	BOOL _sourceAtEnd;
+	BOOL _deflateFinished;
+
+	@private
+	NSStreamStatus _streamStatus;
+}
+
+/**
+ * Returns the gzip compressed contents of a data object
+ */
++ (NSData*)gzippedDataWithData:(NSData*)data;
+
+/**
+ * Initialize a stream compressing the bytes read from another stream. The source stream is
+ * opened and closed along with this one
+ */
+- (id)initWithInputStream:(NSInputStream*)sourceStream;
+
+/**
+ * Initialize a stream compressing the contents of a data object
+ */
+- (id)initWithData:(NSData*)data;
+
+@end
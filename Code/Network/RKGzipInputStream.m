@@ -0,0 +1,158 @@
+//
+//  RKGzipInputStream.m
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import "RKGzipInputStream.h"
+
+// The size of the chunks read from the source stream
+static const NSUInteger kRKGzipInputStreamBufferSize = 32 * 1024;
+
+// Adding 16 to the window bits makes zlib write a gzip header and trailer instead of a zlib wrapper
+static const int kRKGzipWindowBits = MAX_WBITS + 16;
+static const int kRKGzipMemoryLevel = 8;
+
+@implementation RKGzipInputStream
+
++ (NSData*)gzippedDataWithData:(NSData*)data {
+	z_stream zStream;
+	memset(&zStream, 0, sizeof(zStream));
+	if (deflateInit2(&zStream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, kRKGzipWindowBits, kRKGzipMemoryLevel, Z_DEFAULT_STRATEGY) != Z_OK) {
+		return nil;
+	}
+
+	// The gzip wrapper adds 18 bytes to the bound zlib computes for its own
+	NSMutableData* compressedData = [NSMutableData dataWithLength:deflateBound(&zStream, [data length]) + 18];
+	zStream.next_in = (Bytef*)[data bytes];
+	zStream.avail_in = (uInt)[data length];
+	zStream.next_out = [compressedData mutableBytes];
+	zStream.avail_out = (uInt)[compressedData length];
+	int status = deflate(&zStream, Z_FINISH);
+	[compressedData setLength:zStream.total_out];
+	deflateEnd(&zStream);
+
+	return (status == Z_STREAM_END) ? compressedData : nil;
+}
+
+- (id)initWithInputStream:(NSInputStream*)sourceStream {
+	if ((self = [super init])) {
+		_sourceStream = [sourceStream retain];
+		_sourceBuffer = malloc(kRKGzipInputStreamBufferSize);
+	}
+
+	return self;
+}
+
+- (id)initWithData:(NSData*)data {
+	if ((self = [super init])) {
+		_sourceData = [data retain];
+	}
+
+	return self;
+}
+
+- (void)dealloc {
+	if (_isDeflating) {
+		deflateEnd(&_zStream);
+	}
+	[_sourceStream release];
+	[_sourceData release];
+	free(_sourceBuffer);
+	[super dealloc];
+}
+
+#pragma mark NSInputStream methods
+
+- (NSInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)maxLength {
+	if (NO == _isDeflating) {
+		return (_deflateFinished) ? 0 : -1;
+	}
+
+	_streamStatus = NSStreamStatusReading;
+	_zStream.next_out = buffer;
+	_zStream.avail_out = (uInt)maxLength;
+	while (_zStream.avail_out > 0 && NO == _deflateFinished) {
+		// Refill the input window from the source stream once deflate has consumed it
+		if (_zStream.avail_in == 0 && NO == _sourceAtEnd) {
+			NSInteger bytesRead = [_sourceStream read:_sourceBuffer maxLength:kRKGzipInputStreamBufferSize];
+			if (bytesRead < 0) {
+				_streamStatus = NSStreamStatusError;
+				return -1;
+			}
+
+			_sourceAtEnd = (bytesRead == 0);
+			_zStream.next_in = _sourceBuffer;
+			_zStream.avail_in = (uInt)bytesRead;
+		}
+
+		int status = deflate(&_zStream, _sourceAtEnd ? Z_FINISH : Z_NO_FLUSH);
+		if (status == Z_STREAM_END) {
+			_deflateFinished = YES;
+		} else if (status != Z_OK && status != Z_BUF_ERROR) {
+			NSLog(@"[RestKit] RKGzipInputStream: Failed to compress the stream: %s", _zStream.msg);
+			_streamStatus = NSStreamStatusError;
+			return -1;
+		}
+	}
+
+	return maxLength - _zStream.avail_out;
+}
+
+- (BOOL)getBuffer:(uint8_t **)buffer length:(NSUInteger *)len {
+	return NO;
+}
+
+- (BOOL)hasBytesAvailable {
+	return NO == _deflateFinished;
+}
+
+- (void)open {
+	memset(&_zStream, 0, sizeof(_zStream));
+	if (deflateInit2(&_zStream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, kRKGzipWindowBits, kRKGzipMemoryLevel, Z_DEFAULT_STRATEGY) != Z_OK) {
+		_streamStatus = NSStreamStatusError;
+		return;
+	}
+	_isDeflating = YES;
+
+	if (_sourceData) {
+		// Data is compressed in place, without copying it through the buffer
+		_zStream.next_in = (Bytef*)[_sourceData bytes];
+		_zStream.avail_in = (uInt)[_sourceData length];
+		_sourceAtEnd = YES;
+	} else {
+		[_sourceStream open];
+	}
+
+	_streamStatus = NSStreamStatusOpen;
+}
+
+- (void)close {
+	if (_isDeflating) {
+		deflateEnd(&_zStream);
+		_isDeflating = NO;
+	}
+	[_sourceStream close];
+
+	_streamStatus = NSStreamStatusClosed;
+}
+
+- (NSStreamStatus)streamStatus {
+	if (_streamStatus != NSStreamStatusClosed && _streamStatus != NSStreamStatusError && _deflateFinished) {
+		_streamStatus = NSStreamStatusAtEnd;
+	}
+
+	return _streamStatus;
+}
+
+#pragma mark Core Foundation stream methods
+
+- (void)_scheduleInCFRunLoop:(NSRunLoop *)runLoop forMode:(id)mode {
+}
+
+- (void)_setCFClientFlags:(CFOptionFlags)flags callback:(CFReadStreamClientCallBack)callback context:(CFStreamClientContext)context {
+}
+
+@end
@@ -14,8 +14,20 @@
  */
 @interface RKJSONSerialization : NSObject <RKRequestSerializable> {
 	NSObject* _object;
+	BOOL _streamsLargeObjects;
+	BOOL _hasCountedValues;
+	BOOL _isLargeObject;
 }
 
+/**
+ * When YES and the JSON parser supports it, objects holding a thousand values or more are
+ * serialized a chunk at a time as the request body is sent rather than up front. Streamed
+ * bodies are sent chunked without a Content-Length, which not every server accepts
+ *
+ * @default NO
+ */
+@property (nonatomic, assign) BOOL streamsLargeObjects;
+
 /**
  * Returns a RestKit JSON serializable representation of object
  */
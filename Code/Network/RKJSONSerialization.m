@@ -10,8 +10,31 @@
 #import "NSObject+RKJSONSerialization.h"
 #import "RKJSONParser.h"
 
+// Objects with at least this many values are serialized while the body is sent instead of up front
+static const NSUInteger kRKJSONSerializationStreamingThreshold = 1000;
+
+// Counts the values nested in an object, giving up once the count reaches the limit
+static NSUInteger RKJSONSerializationCountValues(id object, NSUInteger limit) {
+	NSUInteger count = 1;
+	if ([object isKindOfClass:[NSDictionary class]]) {
+		object = [object allValues];
+	}
+	if ([object isKindOfClass:[NSArray class]]) {
+		for (id value in object) {
+			if (count >= limit) {
+				break;
+			}
+			count += RKJSONSerializationCountValues(value, limit - count);
+		}
+	}
+
+	return count;
+}
+
 @implementation RKJSONSerialization
 
+@synthesize streamsLargeObjects = _streamsLargeObjects;
+
 + (id)JSONSerializationWithObject:(NSObject*)object {
 	return [[[self alloc] initWithObject:object] autorelease];
 }
@@ -41,8 +64,33 @@
 	return [[self JSONRepresentation] dataUsingEncoding:NSUTF8StringEncoding];
 }
 
+// Small objects are sent from HTTPBody, so the request carries a Content-Length
+- (NSInputStream*)HTTPBodyStream {
+	if (NO == _streamsLargeObjects) {
+		return nil;
+	}
+
+	RKJSONParser* parser = [[[RKJSONParser alloc] init] autorelease];
+	if (NO == [parser respondsToSelector:@selector(inputStreamWithObject:)]) {
+		return nil;
+	}
+
+	// The body stream is asked for each time the request is prepared, so the object is only walked once
+	if (NO == _hasCountedValues) {
+		_isLargeObject = (RKJSONSerializationCountValues(_object, kRKJSONSerializationStreamingThreshold) >= kRKJSONSerializationStreamingThreshold);
+		_hasCountedValues = YES;
+	}
+	if (NO == _isLargeObject) {
+		return nil;
+	}
+
+	return [parser inputStreamWithObject:_object];
+}
+
 - (BOOL)isEqual:(id)object {
-	if ([object isKindOfClass:[NSString class]]) {
+	if ([object isKindOfClass:[RKJSONSerialization class]]) {
+		return [_object isEqual:((RKJSONSerialization*)object)->_object];
+	} else if ([object isKindOfClass:[NSString class]]) {
 		return [[self JSONRepresentation] isEqualToString:object];
 	} else {
 		NSString* string = [[[[RKJSONParser alloc] init] autorelease] stringFromObject:object];
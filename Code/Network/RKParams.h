@@ -10,20 +10,38 @@
 #import "RKRequestSerializable.h"
 #import "RKParamsAttachment.h"
 
+/**
+ * A contiguous run of bytes in the multi-part body: a MIME header, an attachment body or
+ * a boundary
+ */
+typedef struct {
+	const uint8_t* bytes;
+	NSUInteger length;
+} RKParamsSegment;
+
 /**
  * Provides support for creating multi-part request body for RKRequest
  * objects.
+ *
+ * The body is streamed from a list of segments computed when the stream is requested.
+ * Values and data are sent from memory and files are memory mapped, so reads copy the
+ * bytes straight into the reader's buffer and getBuffer:length: hands out the segments
+ * without copying at all.
  */
 @interface RKParams : NSInputStream <RKRequestSerializable> {
 	NSMutableArray* _attachments;
 	
 	@private
 	NSStreamStatus _streamStatus;
+	NSError* _streamError;
 	NSData* _footer;
+	NSMutableArray* _segmentData;
+	RKParamsSegment* _segments;
+	NSUInteger _segmentCount;
+	NSUInteger _currentSegment;
+	NSUInteger _segmentOffset;
 	NSUInteger _bytesDelivered;
 	NSUInteger _length;
-	NSUInteger _footerLength;
-	NSUInteger _currentPart;
 }
 
 /**
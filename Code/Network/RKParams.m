@@ -13,6 +13,17 @@
  */
 NSString* const kRKStringBoundary = @"0xKhTmLbOuNdArY";
 
+/**
+ * Terminates the body of each part
+ */
+static const uint8_t kRKParamsPartTerminator[] = {'\r', '\n'};
+
+@interface RKParams (Private)
+- (void)buildSegments;
+- (void)addSegmentWithBytes:(const uint8_t*)bytes length:(NSUInteger)length;
+- (void)advanceByLength:(NSUInteger)length;
+@end
+
 @implementation RKParams
 
 + (RKParams*)params {
@@ -29,7 +40,7 @@ NSString* const kRKStringBoundary = @"0xKhTmLbOuNdArY";
 	if (self = [super init]) {
 		_attachments = [NSMutableArray new];
 		_footer       = [[[NSString stringWithFormat:@"--%@--\r\n", kRKStringBoundary] dataUsingEncoding:NSUTF8StringEncoding] retain];
-		_footerLength = [_footer length];
+		_segmentData  = [[NSMutableArray alloc] init];
 	}
 	
 	return self;
@@ -37,6 +48,10 @@ NSString* const kRKStringBoundary = @"0xKhTmLbOuNdArY";
 
 - (void)dealloc {
 	[_attachments release];
+	[_footer release];
+	[_segmentData release];
+	[_streamError release];
+	free(_segments);
 	[super dealloc];
 }
 
@@ -114,71 +129,136 @@ NSString* const kRKStringBoundary = @"0xKhTmLbOuNdArY";
 	return [NSString stringWithFormat:@"multipart/form-data; boundary=%@", kRKStringBoundary];
 }
 
+// Known up front, as it is computed from the attachments rather than from the stream
 - (NSUInteger)HTTPHeaderValueForContentLength {
-	return _length;
+	NSUInteger length = [_footer length];
+	for (RKParamsAttachment* attachment in _attachments) {
+		length += [attachment length];
+	}
+	
+	return length;
 }
 
 - (NSInputStream*)HTTPBodyStream {
-	// Open each of our attachments
-	[_attachments makeObjectsPerformSelector:@selector(open)];
+	[self buildSegments];
+	
+	return (NSInputStream*)self;
+}
+
+#pragma mark Segments
+
+- (void)addSegmentWithBytes:(const uint8_t*)bytes length:(NSUInteger)length {
+	// Empty segments are skipped so every segment yields bytes when read
+	if (length == 0) {
+		return;
+	}
+	
+	_segments[_segmentCount].bytes = bytes;
+	_segments[_segmentCount].length = length;
+	_segmentCount++;
+	_length += length;
+}
+
+// Lays out the body as the header, body and terminator of each attachment followed by the footer.
+// The data backing the segments is retained until the segments are built again. Content-Length
+// is computed from the attachments up front, so an attachment whose body no longer matches the
+// length it reported fails the stream rather than sending a short body
+- (void)buildSegments {
+	[_segmentData removeAllObjects];
+	free(_segments);
+	_segments = malloc(sizeof(RKParamsSegment) * ([_attachments count] * 3 + 1));
+	_segmentCount = 0;
+	_currentSegment = 0;
+	_segmentOffset = 0;
+	_bytesDelivered = 0;
+	_length = 0;
+	[_streamError release];
+	_streamError = nil;
 	
-	// Calculate the length	of the stream
-    _length = _footerLength;	
 	for (RKParamsAttachment* attachment in _attachments) {
-		_length += [attachment length];
+		NSData* header = [attachment MIMEHeader];
+		NSData* body = [attachment body];
+		if (nil == _streamError && [header length] + [body length] + sizeof(kRKParamsPartTerminator) != [attachment length]) {
+			NSString* description = [NSString stringWithFormat:@"The file attached for the parameter '%@' could not be read in full", attachment.name];
+			NSMutableDictionary* userInfo = [NSMutableDictionary dictionaryWithObject:description forKey:NSLocalizedDescriptionKey];
+			if (attachment.filePath) {
+				[userInfo setObject:attachment.filePath forKey:NSFilePathErrorKey];
+			}
+			_streamError = [[NSError alloc] initWithDomain:NSCocoaErrorDomain code:NSFileReadUnknownError userInfo:userInfo];
+		}
+		[_segmentData addObject:header];
+		if (body) {
+			[_segmentData addObject:body];
+		}
+		
+		[self addSegmentWithBytes:[header bytes] length:[header length]];
+		[self addSegmentWithBytes:[body bytes] length:[body length]];
+		[self addSegmentWithBytes:kRKParamsPartTerminator length:sizeof(kRKParamsPartTerminator)];
 	}
+	[self addSegmentWithBytes:[_footer bytes] length:[_footer length]];
 	
-	return (NSInputStream*)self;
+	_streamStatus = _streamError ? NSStreamStatusError : NSStreamStatusNotOpen;
+}
+
+- (void)advanceByLength:(NSUInteger)length {
+	_segmentOffset += length;
+	_bytesDelivered += length;
+	if (_segmentOffset >= _segments[_currentSegment].length) {
+		_currentSegment++;
+		_segmentOffset = 0;
+	}
 }
 
 #pragma mark NSInputStream methods
 
 - (NSInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)maxLength {
-    NSUInteger bytesSentInThisRead = 0, bytesRead;
-	NSUInteger lengthOfAttachments = (_length - _footerLength);
+    NSUInteger bytesSentInThisRead = 0;
 	
-	// Proxy the read through to our attachments
-    _streamStatus = NSStreamStatusReading;
-    while (_bytesDelivered < _length && bytesSentInThisRead < maxLength && _currentPart < [_attachments count]) {
-        if ((bytesRead = [[_attachments objectAtIndex:_currentPart] read:buffer + bytesSentInThisRead maxLength:maxLength - bytesSentInThisRead]) == 0) {
-            _currentPart ++;
-            continue;
-        }
-		
-        bytesSentInThisRead += bytesRead;
-        _bytesDelivered += bytesRead;
-    }
+	if (_streamError) {
+		return -1;
+	}
 	
-	// If we have sent all the attachments data, begin emitting the boundary footer
-    if ((_bytesDelivered >= lengthOfAttachments) && (bytesSentInThisRead < maxLength)) {
-		NSUInteger footerBytesSent, footerBytesRemaining, bytesRemainingInBuffer;
-		
-		// Calculate our position in the stream & buffer
-		footerBytesSent = _bytesDelivered - lengthOfAttachments;
-		footerBytesRemaining = _footerLength - footerBytesSent;
-		bytesRemainingInBuffer = maxLength - bytesSentInThisRead;
-		
-		// Send the entire footer back if there is room
-        bytesRead = (footerBytesRemaining < bytesRemainingInBuffer) ? footerBytesRemaining : bytesRemainingInBuffer;		
-        [_footer getBytes:buffer + bytesSentInThisRead range:NSMakeRange(footerBytesSent, bytesRead)];
+    _streamStatus = NSStreamStatusReading;
+    while (bytesSentInThisRead < maxLength && _currentSegment < _segmentCount) {
+		RKParamsSegment* segment = &_segments[_currentSegment];
+		NSUInteger length = MIN(segment->length - _segmentOffset, maxLength - bytesSentInThisRead);
+		memcpy(buffer + bytesSentInThisRead, segment->bytes + _segmentOffset, length);
 		
-        bytesSentInThisRead += bytesRead;
-        _bytesDelivered += bytesRead;
+        bytesSentInThisRead += length;
+		[self advanceByLength:length];
     }
 	
     return bytesSentInThisRead;
 }
 
+// Hands out the rest of the current segment without copying. As with CFReadStreamGetBuffer,
+// the returned bytes are consumed and the buffer stays valid until the segments are rebuilt
 - (BOOL)getBuffer:(uint8_t **)buffer length:(NSUInteger *)len {
-	return NO;
+	if (_streamError || _currentSegment >= _segmentCount) {
+		return NO;
+	}
+	
+	RKParamsSegment* segment = &_segments[_currentSegment];
+	*buffer = (uint8_t*)segment->bytes + _segmentOffset;
+	*len = segment->length - _segmentOffset;
+	_streamStatus = NSStreamStatusReading;
+	[self advanceByLength:*len];
+	
+	return YES;
 }
 
+// A failed stream reports bytes available so that its reader calls read: and receives the error
 - (BOOL)hasBytesAvailable {
-    return _bytesDelivered < _length;
+    return _streamError || _currentSegment < _segmentCount;
 }
 
 - (void)open {
-    _streamStatus = NSStreamStatusOpen;
+	if (NULL == _segments) {
+		[self buildSegments];
+	}
+	if (nil == _streamError) {
+		_streamStatus = NSStreamStatusOpen;
+	}
 }
 
 - (void)close {
@@ -186,13 +266,20 @@ NSString* const kRKStringBoundary = @"0xKhTmLbOuNdArY";
 }
 
 - (NSStreamStatus)streamStatus {
-    if (_streamStatus != NSStreamStatusClosed && _bytesDelivered >= _length) {
+	if (_streamError) {
+		return NSStreamStatusError;
+	}
+    if (_streamStatus != NSStreamStatusClosed && _streamStatus != NSStreamStatusNotOpen && _bytesDelivered >= _length) {
         _streamStatus = NSStreamStatusAtEnd;
     }
 	
     return _streamStatus;
 }
 
+- (NSError*)streamError {
+	return _streamError;
+}
+
 #pragma mark Core Foundation stream methods
 
 - (void)_scheduleInCFRunLoop:(NSRunLoop *)runLoop forMode:(id)mode {
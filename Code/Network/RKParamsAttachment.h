@@ -21,11 +21,9 @@
 
 	@private
 	NSData*			_MIMEHeader;
-	NSUInteger		_MIMEHeaderLength;
-	NSInputStream*  _bodyStream;
+	NSData*			_bodyData;
+	NSString*		_filePath;
 	NSUInteger		_bodyLength;
-	NSUInteger		_length;
-	NSUInteger		_delivered;
 }
 
 /**
@@ -47,6 +45,11 @@
  */
 @property (nonatomic, retain) NSString* MIMEType;
 
+/**
+ * The path of the attached file, or nil when the attachment is not a file
+ */
+@property (nonatomic, readonly) NSString* filePath;
+
 /**
  * The MIME boundary string
  */
@@ -68,19 +71,21 @@
 - (id)initWithName:(NSString*)name file:(NSString*)filePath;
 
 /**
- * Open the attachment stream to begin reading. This will generate a MIME header and prepare the
- * attachment for writing to an RKParams stream
+ * The MIME header of this part, including the leading boundary. Generated from the name,
+ * file name and MIME type when first requested after any of them change
  */
-- (void)open;
+- (NSData*)MIMEHeader;
 
 /**
- * The length of the entire attachment (including the MIME Header and the body)
+ * The body of this part. The contents of attached files are memory mapped rather than read,
+ * so each call maps the file anew. Returns nil when the attached file cannot be mapped
  */
-- (NSUInteger)length;
+- (NSData*)body;
 
 /**
- * Read the attachment body in a streaming fashion
+ * The length of the entire attachment (including the MIME Header and the body). Known
+ * before the attachment is opened
  */
-- (NSUInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)len;
+- (NSUInteger)length;
 
 @end
@@ -14,13 +14,18 @@
  */
 extern NSString* const kRKStringBoundary;
 
+/**
+ * The length of the \r\n terminating each part
+ */
+static const NSUInteger kRKParamsAttachmentTerminatorLength = 2;
+
 @interface RKParamsAttachment (Private)
 - (NSString *)mimeTypeForExtension:(NSString *)extension;
 @end
 
 @implementation RKParamsAttachment
 
-@synthesize fileName = _fileName, MIMEType = _MIMEType, name = _name;
+@synthesize fileName = _fileName, MIMEType = _MIMEType, name = _name, filePath = _filePath;
 
 - (id)initWithName:(NSString*)name {
 	if ((self = [self init])) {
@@ -32,15 +37,12 @@ extern NSString* const kRKStringBoundary;
 
 - (id)initWithName:(NSString*)name value:(id<NSObject>)value {
 	if ((self = [self initWithName:name])) {
-		NSMutableData* body = [NSMutableData data];
 		if ([value respondsToSelector:@selector(dataUsingEncoding:)]) {
-			[body appendData:[(NSString*)value dataUsingEncoding:NSUTF8StringEncoding]];
+			_bodyData = [[(NSString*)value dataUsingEncoding:NSUTF8StringEncoding] retain];
 		} else {
-			[body appendData:[[NSString stringWithFormat:@"%@", value] dataUsingEncoding:NSUTF8StringEncoding]];
+			_bodyData = [[[NSString stringWithFormat:@"%@", value] dataUsingEncoding:NSUTF8StringEncoding] retain];
 		}
-		
-		_bodyStream    = [[NSInputStream inputStreamWithData:body] retain];
-		_bodyLength    = [body length];
+		_bodyLength = [_bodyData length];
 	}
 	
 	return self;
@@ -48,8 +50,8 @@ extern NSString* const kRKStringBoundary;
 
 - (id)initWithName:(NSString*)name data:(NSData*)data {
 	if ((self = [self initWithName:name])) {		
-		_bodyStream    = [[NSInputStream inputStreamWithData:data] retain];
-		_bodyLength    = [data length];
+		_bodyData = [data retain];
+		_bodyLength = [data length];
 	}
 	
 	return self;
@@ -60,7 +62,7 @@ extern NSString* const kRKStringBoundary;
 		NSAssert1([[NSFileManager defaultManager] fileExistsAtPath:filePath], @"Expected file to exist at path: %@", filePath);
 		_fileName = [[filePath lastPathComponent] retain];
 		_MIMEType = [[self mimeTypeForExtension:[filePath pathExtension]] retain];
-		_bodyStream    = [[NSInputStream inputStreamWithFileAtPath:filePath] retain];
+		_filePath = [filePath copy];
 		
 		NSError* error = nil;		
 		_bodyLength    = [[[[NSFileManager defaultManager] attributesOfItemAtPath:filePath error:&error] objectForKey:NSFileSize] unsignedIntegerValue];		
@@ -73,19 +75,46 @@ extern NSString* const kRKStringBoundary;
 }
 
 - (void)dealloc {
+	[_name release];
 	[_fileName release];
 	[_MIMEType release];
 	
 	[_MIMEHeader release];
 	_MIMEHeader = nil;
 	
-    [_bodyStream close];
-	[_bodyStream release];
-	_bodyStream = nil;
+	[_bodyData release];
+	_bodyData = nil;
+	[_filePath release];
+	_filePath = nil;
 	
     [super dealloc];
 }
 
+// The MIME header is regenerated once any of the values it is made of change
+- (void)setName:(NSString*)name {
+	[name retain];
+	[_name release];
+	_name = name;
+	[_MIMEHeader release];
+	_MIMEHeader = nil;
+}
+
+- (void)setFileName:(NSString*)fileName {
+	[fileName retain];
+	[_fileName release];
+	_fileName = fileName;
+	[_MIMEHeader release];
+	_MIMEHeader = nil;
+}
+
+- (void)setMIMEType:(NSString*)MIMEType {
+	[MIMEType retain];
+	[_MIMEType release];
+	_MIMEType = MIMEType;
+	[_MIMEHeader release];
+	_MIMEHeader = nil;
+}
+
 - (NSString*)MIMEBoundary {
 	return kRKStringBoundary;
 }
@@ -107,86 +136,38 @@ extern NSString* const kRKStringBoundary;
     return @"application/octet-stream";
 }
 
-#pragma mark NSStream methods
-
-- (void)open {
-	// Generate the MIME header for this part
-	if (self.fileName && self.MIMEType) {
-		// Typical for file attachments
-		_MIMEHeader = [[[NSString stringWithFormat:@"--%@\r\nContent-Disposition: form-data; name=\"%@\"; "
-												   @"filename=\"%@\"\r\nContent-Type: %@\r\n\r\n", 
-						 [self MIMEBoundary], self.name, self.fileName, self.MIMEType] dataUsingEncoding:NSUTF8StringEncoding] retain];
-	} else if (self.MIMEType) {
-		// Typical for data values
-		_MIMEHeader = [[[NSString stringWithFormat:@"--%@\r\nContent-Disposition: form-data; name=\"%@\"\r\n"
-												   @"Content-Type: %@\r\n\r\n", 
-						 [self MIMEBoundary], self.name, self.MIMEType] dataUsingEncoding:NSUTF8StringEncoding] retain];
-	} else {
-		// Typical for raw values
-		_MIMEHeader = [[[NSString stringWithFormat:@"--%@\r\nContent-Disposition: form-data; name=\"%@\"\r\n\r\n", 
-						 [self MIMEBoundary], self.name] 
-						dataUsingEncoding:NSUTF8StringEncoding] retain];
+- (NSData*)MIMEHeader {
+	if (nil == _MIMEHeader) {
+		NSMutableString* header = [NSMutableString stringWithFormat:@"--%@\r\nContent-Disposition: form-data; name=\"%@\"", [self MIMEBoundary], self.name];
+		if (self.fileName && self.MIMEType) {
+			// Typical for file attachments
+			[header appendFormat:@"; filename=\"%@\"", self.fileName];
+		}
+		if (self.MIMEType) {
+			// Typical for file attachments and data values
+			[header appendFormat:@"\r\nContent-Type: %@", self.MIMEType];
+		}
+		[header appendString:@"\r\n\r\n"];
+		_MIMEHeader = [[header dataUsingEncoding:NSUTF8StringEncoding] retain];
 	}
 	
-	// Calculate lengths
-	_MIMEHeaderLength = [_MIMEHeader length];
-	_length = _MIMEHeaderLength + _bodyLength + 2; // \r\n is the + 2
-	
-	// Open the stream
-    [_bodyStream open];
+	return _MIMEHeader;
 }
 
-- (NSUInteger)length {
-    return _length;
+- (NSData*)body {
+	if (_filePath) {
+		NSData* body = [NSData dataWithContentsOfMappedFile:_filePath];
+		if (nil == body) {
+			NSLog(@"[RestKit] RKParamsAttachment: Failed to map the file at path: %@", _filePath);
+		}
+		return body;
+	}
+	
+	return _bodyData;
 }
 
-- (NSUInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)maxLength {
-    NSUInteger sent = 0, read;
-	
-	// We are done with the read
-    if (_delivered >= _length) {
-        return 0;
-    }
-	
-	// First we send back the MIME headers
-    if (_delivered < _MIMEHeaderLength && sent < maxLength) {
-		NSUInteger headerBytesRemaining, bytesRemainingInBuffer;
-		
-		headerBytesRemaining = _MIMEHeaderLength - _delivered;
-		bytesRemainingInBuffer = maxLength - sent;
-		
-		// Send the entire header if there is room
-        read       = (headerBytesRemaining < bytesRemainingInBuffer) ? headerBytesRemaining : bytesRemainingInBuffer;
-        [_MIMEHeader getBytes:buffer + sent range:NSMakeRange(_delivered, read)];
-		
-        sent += read;
-        _delivered += sent;
-    }
-	
-	// Read the attachment body out of our underlying stream
-    while (_delivered >= _MIMEHeaderLength && _delivered < (_length - 2) && sent < maxLength) {
-        if ((read = [_bodyStream read:(buffer + sent) maxLength:(maxLength - sent)]) == 0) {
-            break;
-        }
-		
-        sent += read;
-        _delivered += read;
-    }
-	
-	// Append the \r\n 
-    if (_delivered >= (_length - 2) && sent < maxLength) {
-        if (_delivered == (_length - 2)) {
-            *(buffer + sent) = '\r';
-            sent ++;
-			_delivered ++;
-        }
-		
-        *(buffer + sent) = '\n';
-        sent ++;
-		_delivered ++;
-    }
-	
-    return sent;
+- (NSUInteger)length {
+	return [[self MIMEHeader] length] + _bodyLength + kRKParamsAttachmentTerminatorLength;
 }
 
 @end
@@ -10,6 +10,8 @@
 #import <CoreData/CoreData.h>
 #import "RKRequestSerializable.h"
 #import "RKJSONSerialization.h"
+#import "RKResponseBodySink.h"
+#import "RKRequestMetrics.h"
 
 /**
  * HTTP methods for requests
@@ -21,8 +23,22 @@ typedef enum RKRequestMethod {
 	RKRequestMethodDELETE
 } RKRequestMethod;
 
+/**
+ * Scheduling priorities for requests sent through the request queue
+ */
+typedef enum RKRequestPriority {
+	RKRequestPriorityDefault = 0,	// Ordinary requests
+	RKRequestPriorityInteractive,	// Requests the user is actively waiting on
+	RKRequestPriorityBackground,	// Prefetching and synchronization
+	RKRequestPriorityCount
+} RKRequestPriority;
+
 @class RKResponse;
+@class RKRequestCache;
+@class RKRequestRetryPolicy;
+@class RKRequestQueue;
 @protocol RKRequestDelegate;
+@protocol RKStreamingParser;
 
 @interface RKRequest : NSObject {
 	NSURL* _URL;
@@ -35,9 +51,22 @@ typedef enum RKRequestMethod {
 	NSString* _username;
 	NSString* _password;
 	RKRequestMethod _method;
+	RKRequestPriority _priority;
+	NSMutableArray* _coalescedRequests;
+	RKRequestCache* _cache;
+	RKRequestRetryPolicy* _retryPolicy;
+	RKRequestQueue* _queue;
+	NSUInteger _attemptCount;
+	NSObject<RKRequestMetricsSink>* _metricsSink;
+	RKRequestMetrics* _metrics;
+	NSObject<RKResponseBodySink>* _bodySink;
+	BOOL _downloadsBodyToFile;
+	NSUInteger _bodyCompressionThreshold;
+	BOOL _compressesBody;
+	BOOL _isBodyCompressed;
+	BOOL _acceptsCoalescedRequests;
 	BOOL _isLoading;
 	BOOL _isLoaded;
-    int _fails;
 }
 
 /**
@@ -57,6 +86,14 @@ typedef enum RKRequestMethod {
  */
 @property(nonatomic, assign) RKRequestMethod method;
 
+/**
+ * The priority the request queue dispatches the request with. Takes effect when the
+ * request is sent; changing it while the request is queued has no effect
+ *
+ * @default RKRequestPriorityDefault
+ */
+@property(nonatomic, assign) RKRequestPriority priority;
+
 /**
  * A serializable collection of parameters sent as the HTTP Body of the request
  */
@@ -87,6 +124,77 @@ typedef enum RKRequestMethod {
 @property(nonatomic, retain) NSString* username;
 @property(nonatomic, retain) NSString* password;
 
+/**
+ * The cache GET responses are stored in and revalidated against. When set, a GET for a cached
+ * URL is sent with If-None-Match and If-Modified-Since, and a 304 Not Modified response is
+ * replaced by the cached response. Set from the client the request was created with
+ */
+@property(nonatomic, retain) RKRequestCache* cache;
+
+/**
+ * The policy deciding whether the request is sent again after a connection failure or a transient
+ * error response. Retries are sent back through the queue the request was loading in once the
+ * backoff delay has passed, and the delegate only hears of the outcome of the last attempt.
+ * Synchronous requests wait out the delay on the calling thread. Set from the client the request
+ * was created with. When nil, requests are sent once
+ */
+@property(nonatomic, retain) RKRequestRetryPolicy* retryPolicy;
+
+/**
+ * The queue that dispatched the request, which retries are sent back to. Set by the queue while
+ * the request is loading or waiting to be retried, and nil otherwise
+ */
+@property(nonatomic, assign) RKRequestQueue* queue;
+
+/**
+ * The number of times the request has been sent
+ */
+@property(nonatomic, readonly) NSUInteger attemptCount;
+
+/**
+ * The sink the metrics of the request are delivered to once it has finished. Metrics are only
+ * collected when a sink is set. Set from the client the request was created with
+ */
+@property(nonatomic, retain) NSObject<RKRequestMetricsSink>* metricsSink;
+
+/**
+ * The metrics collected since the request was last sent, or nil when it has no metrics sink
+ */
+@property(nonatomic, readonly) RKRequestMetrics* metrics;
+
+/**
+ * When YES, a body of at least bodyCompressionThreshold bytes is sent gzip compressed with a
+ * Content-Encoding: gzip header. Large bodies and bodies provided as streams are compressed
+ * while they are uploaded and sent without a Content-Length. Set from the client the request
+ * was created with. The server must accept compressed request bodies
+ *
+ * @default NO
+ */
+@property(nonatomic, assign) BOOL compressesBody;
+
+/**
+ * The size in bytes below which bodies are sent uncompressed even when compressesBody is YES.
+ * Bodies provided as streams of unknown length are always compressed
+ *
+ * @default 1024
+ */
+@property(nonatomic, assign) NSUInteger bodyCompressionThreshold;
+
+/**
+ * A sink the body of a successful response is written to as it downloads, in place of being
+ * accumulated in memory. The response body is then the data of the sink. A sink consumes a
+ * single response, so a new one must be set before the request is sent again
+ */
+@property(nonatomic, retain) NSObject<RKResponseBodySink>* bodySink;
+
+/**
+ * When YES and no bodySink is set, the body of a successful response is written to a temporary
+ * file as it downloads and the response body is memory mapped from the file
+ *
+ * @default NO
+ */
+@property(nonatomic, assign) BOOL downloadsBodyToFile;
+
 /**
  * The underlying NSMutableURLRequest sent for this request
  */
@@ -138,6 +246,65 @@ typedef enum RKRequestMethod {
  */
 - (void)didFinishLoad:(RKResponse*)response;
 
+/**
+ * Completes the metrics of the request and delivers them to the metrics sink. Invoked when the
+ * request has finished loading the response or failed with the error
+ */
+- (void)didCollectMetricsWithResponse:(RKResponse*)response error:(NSError*)error;
+
+/**
+ * Invoked by the response when the connection has failed with an error, in which case response
+ * is nil, or has finished loading the response. Returns YES when the retry policy sends the
+ * request again, in which case the attempt is abandoned without informing the delegate
+ */
+- (BOOL)retryAfterResponse:(RKResponse*)response error:(NSError*)error;
+
+/**
+ * Invoked by the response once the response headers have arrived. Returning a parser
+ * causes the body to be parsed chunk by chunk as it downloads instead of being buffered.
+ * Returns nil by default.
+ */
+- (NSObject<RKStreamingParser>*)streamingParserForResponse:(RKResponse*)response;
+
+/**
+ * Invoked by the response once the response headers have arrived, when there is no streaming
+ * parser for the response. Returning a sink causes the body to be written to the sink as it
+ * downloads instead of being buffered. By default returns the bodySink, or a temporary file
+ * sink when downloadsBodyToFile is YES, for successful responses
+ */
+- (NSObject<RKResponseBodySink>*)bodySinkForResponse:(RKResponse*)response;
+
+/**
+ * Returns a key identifying the response this request would load, or nil when the request
+ * must not share its response with others. Requests with the same key that are queued at the
+ * same time share a single connection. By default only GET requests without a body have a key,
+ * made up of the class, URL and additional headers of the request and a digest of its credentials.
+ */
+- (NSString*)coalescingKey;
+
+/**
+ * Attaches a request with the same coalescing key to this one. The attached request is sent no
+ * connection of its own and is finished with this request's outcome. Returns NO if this request
+ * has already finished and can no longer accept requests.
+ */
+- (BOOL)addCoalescedRequest:(RKRequest*)request;
+
+/**
+ * Detaches a request attached with addCoalescedRequest:. Returns NO if it was not attached
+ */
+- (BOOL)removeCoalescedRequest:(RKRequest*)request;
+
+/**
+ * The requests currently attached to this one
+ */
+- (NSArray*)coalescedRequests;
+
+/**
+ * Detaches and returns every attached request and stops accepting new ones. Invoked when this
+ * request finishes so the returned requests can be finished the same way
+ */
+- (NSArray*)takeCoalescedRequests;
+
 /**
  * Cancels the underlying URL connection
  */
@@ -8,6 +8,10 @@
 
 #import "RKRequest.h"
 #import "RKRequestQueue.h"
+#import "RKRequestCache.h"
+#import "RKRequestRetryPolicy.h"
+#import "RKGzipInputStream.h"
+#import "RKResponseFileSink.h"
 #import "RKResponse.h"
 #import "NSDictionary+RKRequestSerialization.h"
 #import "RKNotifications.h"
@@ -18,11 +22,23 @@
 
 #define NSLog(__FORMAT__, ...) TFLog((@"%s [Line %d] " __FORMAT__), __PRETTY_FUNCTION__, __LINE__, ##__VA_ARGS__)
 
+// In memory bodies at least this large are compressed while they are sent instead of up front
+static const NSUInteger kRKRequestStreamingCompressionThreshold = 256 * 1024;
+
+// Coalescing keys are kept in memory and may be logged, so they only carry a digest of the credentials
+static NSString* RKRequestCredentialsDigest(NSString* username, NSString* password) {
+	return RKSHA1HexDigestOfString([NSString stringWithFormat:@"%@:%@", username, password]);
+}
+
 
 @implementation RKRequest
 
 @synthesize URL = _URL, URLRequest = _URLRequest, delegate = _delegate, additionalHTTPHeaders = _additionalHTTPHeaders,
-			params = _params, userData = _userData, username = _username, password = _password, method = _method;
+			params = _params, userData = _userData, username = _username, password = _password, method = _method,
+			priority = _priority, cache = _cache, retryPolicy = _retryPolicy, queue = _queue, attemptCount = _attemptCount,
+			metricsSink = _metricsSink, metrics = _metrics, bodySink = _bodySink, downloadsBodyToFile = _downloadsBodyToFile,
+			compressesBody = _compressesBody,
+			bodyCompressionThreshold = _bodyCompressionThreshold;
 
 + (RKRequest*)requestWithURL:(NSURL*)URL delegate:(id)delegate {
 	return [[[RKRequest alloc] initWithURL:URL delegate:delegate] autorelease];
@@ -35,7 +51,10 @@
 		_connection = nil;
 		_isLoading = NO;
 		_isLoaded = NO;
-        _fails = 0;
+		_acceptsCoalescedRequests = YES;
+		_compressesBody = NO;
+		_bodyCompressionThreshold = 1024;
+		_attemptCount = 0;
         [_URLRequest setTimeoutInterval: 30];
 	}
 	return self;
@@ -44,7 +63,6 @@
 - (id)initWithURL:(NSURL*)URL delegate:(id)delegate {
 	if (self = [self initWithURL:URL]) {
 		_delegate = delegate;
-        _fails = 0;
 	}
 	return self;
 }
@@ -68,16 +86,45 @@
 	_username = nil;
 	[_password release];
 	_password = nil;
+	[_coalescedRequests release];
+	_coalescedRequests = nil;
+	[_cache release];
+	_cache = nil;
+	[_retryPolicy release];
+	_retryPolicy = nil;
+	[_metricsSink release];
+	_metricsSink = nil;
+	[_metrics release];
+	_metrics = nil;
+	[_bodySink release];
+	_bodySink = nil;
 	[super dealloc];
 }
 
 - (void)setRequestBody {
+	_isBodyCompressed = NO;
 	if (_params) {
 		// Prefer the use of a stream over a raw body
-		if ([_params respondsToSelector:@selector(HTTPBodyStream)]) {
-			[_URLRequest setHTTPBodyStream:[_params HTTPBodyStream]];
+		NSInputStream* stream = [_params respondsToSelector:@selector(HTTPBodyStream)] ? [_params HTTPBodyStream] : nil;
+		if (stream) {
+			BOOL isLengthKnown = [_params respondsToSelector:@selector(HTTPHeaderValueForContentLength)];
+			if (_compressesBody && (NO == isLengthKnown || [_params HTTPHeaderValueForContentLength] >= _bodyCompressionThreshold)) {
+				stream = [[[RKGzipInputStream alloc] initWithInputStream:stream] autorelease];
+				_isBodyCompressed = YES;
+			}
+			[_URLRequest setHTTPBodyStream:stream];
 		} else {
-			[_URLRequest setHTTPBody:[_params HTTPBody]];
+			NSData* body = [_params HTTPBody];
+			if (_compressesBody && [body length] >= kRKRequestStreamingCompressionThreshold) {
+				[_URLRequest setHTTPBodyStream:[[[RKGzipInputStream alloc] initWithData:body] autorelease]];
+				_isBodyCompressed = YES;
+			} else if (_compressesBody && [body length] >= _bodyCompressionThreshold) {
+				NSData* compressedBody = [RKGzipInputStream gzippedDataWithData:body];
+				_isBodyCompressed = (nil != compressedBody);
+				[_URLRequest setHTTPBody:(_isBodyCompressed ? compressedBody : body)];
+			} else {
+				[_URLRequest setHTTPBody:body];
+			}
 		}
 	}
 }
@@ -88,6 +135,9 @@
 		[_URLRequest setValue:[_additionalHTTPHeaders valueForKey:header] forHTTPHeaderField:header];
 	}
 
+	// A request prepared again must not keep the encoding or length of a body it was prepared with before
+	NSString* contentEncoding = [_additionalHTTPHeaders valueForKey:@"Content-Encoding"];
+	NSString* contentLength = [_additionalHTTPHeaders valueForKey:@"Content-Length"];
 	if (_params != nil) {
 		// Temporarily support older RKRequestSerializable implementations
 		if ([_params respondsToSelector:@selector(HTTPHeaderValueForContentType)]) {
@@ -95,10 +145,16 @@
 		} else if ([_params respondsToSelector:@selector(ContentTypeHTTPHeader)]) {
 			[_URLRequest setValue:[_params performSelector:@selector(ContentTypeHTTPHeader)] forHTTPHeaderField:@"Content-Type"];
 		}
-		if ([_params respondsToSelector:@selector(HTTPHeaderValueForContentLength)]) {
-			[_URLRequest setValue:[NSString stringWithFormat:@"%d", [_params HTTPHeaderValueForContentLength]] forHTTPHeaderField:@"Content-Length"];
+		if (_isBodyCompressed) {
+			// Compressed streams are sent chunked, as their length is only known once they are read
+			contentEncoding = @"gzip";
+			contentLength = [_URLRequest HTTPBody] ? [NSString stringWithFormat:@"%lu", (unsigned long)[[_URLRequest HTTPBody] length]] : nil;
+		} else if ([_params respondsToSelector:@selector(HTTPHeaderValueForContentLength)]) {
+			contentLength = [NSString stringWithFormat:@"%lu", (unsigned long)[_params HTTPHeaderValueForContentLength]];
 		}
 	}
+	[_URLRequest setValue:contentEncoding forHTTPHeaderField:@"Content-Encoding"];
+	[_URLRequest setValue:contentLength forHTTPHeaderField:@"Content-Length"];
 
     if (_username != nil) {
         // Add authentication headers so we don't have to deal with an extra cycle for each message requiring basic auth.
@@ -111,6 +167,11 @@
         CFRelease(dummyRequest);
         CFRelease(authorizationString);
     }
+
+	// Added last, as the cache entry depends on the headers the response varies on
+	if (_cache && [self isGET]) {
+		[_cache addConditionalHeadersToRequest:self];
+	}
 	NSLog(@"Headers: %@", [_URLRequest allHTTPHeaderFields]);
 }
 
@@ -141,7 +202,23 @@
 	}
 }
 
+- (void)resetMetrics {
+	[_metrics release];
+	_metrics = (_metricsSink ? [[RKRequestMetrics alloc] initWithRequest:self] : nil);
+}
+
+- (void)didSendAttempt {
+	NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+	if (0 == _metrics.firstSentTime) {
+		_metrics.firstSentTime = now;
+	}
+	_metrics.sentTime = now;
+	_metrics.firstByteTime = 0;
+	_metrics.finishTime = 0;
+}
+
 - (void)send {
+	[self resetMetrics];
 	[[RKRequestQueue sharedQueue] sendRequest:self];
 }
 
@@ -156,6 +233,8 @@
 		[[NSNotificationCenter defaultCenter] postNotificationName:kRKRequestSentNotification object:self userInfo:userInfo];
 
 		_isLoading = YES;
+		_attemptCount++;
+		[self didSendAttempt];
 		RKResponse* response = [[[RKResponse alloc] initWithRequest:self] autorelease];
 		_connection = [[NSURLConnection connectionWithRequest:_URLRequest delegate:response] retain];
 	} else {
@@ -174,18 +253,49 @@
 	NSData* payload = nil;
 	RKResponse* response = nil;
 
+	[self resetMetrics];
 	if ([[RKClient sharedClient] isNetworkAvailable]) {
-		[self prepareURLRequest];
-		NSString* body = [[NSString alloc] initWithData:[_URLRequest HTTPBody] encoding:NSUTF8StringEncoding];
-		NSLog(@"Sending synchronous %@ request to URL %@. HTTP Body: %@", [self HTTPMethod], [[self URL] absoluteString], body);
-		[body release];
-		NSDate* sentAt = [NSDate date];
-		NSDictionary* userInfo = [NSDictionary dictionaryWithObjectsAndKeys:[self HTTPMethod], @"HTTPMethod", [self URL], @"URL", sentAt, @"sentAt", nil];
-		[[NSNotificationCenter defaultCenter] postNotificationName:kRKRequestSentNotification object:self userInfo:userInfo];
-
-		_isLoading = YES;
-		payload = [NSURLConnection sendSynchronousRequest:_URLRequest returningResponse:&URLResponse error:&error];
-		response = [[[RKResponse alloc] initWithSynchronousRequest:self URLResponse:URLResponse body:payload error:error] autorelease];
+		BOOL isRetrying = NO;
+		do {
+			// The body is prepared again for each attempt, as a body stream can only be read once
+			[self prepareURLRequest];
+			NSString* body = [[NSString alloc] initWithData:[_URLRequest HTTPBody] encoding:NSUTF8StringEncoding];
+			NSLog(@"Sending synchronous %@ request to URL %@. HTTP Body: %@", [self HTTPMethod], [[self URL] absoluteString], body);
+			[body release];
+			NSDate* sentAt = [NSDate date];
+			NSDictionary* userInfo = [NSDictionary dictionaryWithObjectsAndKeys:[self HTTPMethod], @"HTTPMethod", [self URL], @"URL", sentAt, @"sentAt", nil];
+			[[NSNotificationCenter defaultCenter] postNotificationName:kRKRequestSentNotification object:self userInfo:userInfo];
+
+			_isLoading = YES;
+			_attemptCount++;
+			[self didSendAttempt];
+			URLResponse = nil;
+			error = nil;
+			payload = [NSURLConnection sendSynchronousRequest:_URLRequest returningResponse:&URLResponse error:&error];
+			_metrics.finishTime = [NSDate timeIntervalSinceReferenceDate];
+			_metrics.bytesSent += [[_URLRequest HTTPBody] length];
+			_metrics.bytesReceived += [payload length];
+			response = [[[RKResponse alloc] initWithSynchronousRequest:self URLResponse:URLResponse body:payload error:error] autorelease];
+
+			// The backoff delay blocks the calling thread, just like the attempts themselves
+			isRetrying = (_retryPolicy && [_retryPolicy shouldRetryRequest:self response:(error ? nil : response) error:error]);
+			if (isRetrying) {
+				NSTimeInterval delay = [_retryPolicy delayBeforeRetryingRequest:self response:(error ? nil : response)];
+				NSLog(@"Retrying synchronous %@ request to URL %@ in %.2f seconds after attempt %lu (status code %ld, error %@)", [self HTTPMethod],
+					  [[self URL] absoluteString], delay, (unsigned long)_attemptCount, (long)(error ? 0 : [response statusCode]), error);
+				[NSThread sleepForTimeInterval:delay];
+			}
+		} while (isRetrying);
+
+		if (_cache && [self isGET] && nil == error) {
+			RKResponse* cachedResponse = ([response statusCode] == 304) ? [_cache responseForRequest:self] : nil;
+			if (cachedResponse) {
+				response = cachedResponse;
+			} else {
+				[_cache storeResponse:response forRequest:self];
+			}
+		}
+		[self didCollectMetricsWithResponse:response error:error];
 	} else {
 		NSString* errorMessage = [NSString stringWithFormat:@"The client is unable to contact the resource at %@", [[self URL] absoluteString]];
 		NSDictionary *userInfo = [NSDictionary dictionaryWithObjectsAndKeys:
@@ -201,33 +311,125 @@
 	return response;
 }
 
-- (void)cancel {
+- (void)didCollectMetricsWithResponse:(RKResponse*)response error:(NSError*)error {
+	if (nil == _metrics) {
+		return;
+	}
+
+	_metrics.completionTime = [NSDate timeIntervalSinceReferenceDate];
+	_metrics.attemptCount = _attemptCount;
+	_metrics.statusCode = (error ? 0 : [response statusCode]);
+	_metrics.error = error;
+	[_metricsSink request:self didCollectMetrics:_metrics];
+}
+
+- (BOOL)retryAfterResponse:(RKResponse*)response error:(NSError*)error {
+	// A body sink provided by the caller has already been handed part of the body
+	if (nil == _retryPolicy || (_bodySink && [response bodySink] == _bodySink)) {
+		return NO;
+	}
+	if (NO == [_retryPolicy shouldRetryRequest:self response:(error ? nil : response) error:error]) {
+		return NO;
+	}
+
+	NSTimeInterval delay = [_retryPolicy delayBeforeRetryingRequest:self response:(error ? nil : response)];
+	NSLog(@"Retrying %@ request to URL %@ in %.2f seconds after attempt %lu (status code %ld, error %@)", [self HTTPMethod],
+		  [[self URL] absoluteString], delay, (unsigned long)_attemptCount, (long)(error ? 0 : [response statusCode]), error);
 	[_connection cancel];
 	[_connection release];
 	_connection = nil;
 	_isLoading = NO;
+
+	// Requests loaded outside of a queue are retried through the shared queue
+	RKRequestQueue* queue = (_queue ? _queue : [RKRequestQueue sharedQueue]);
+	[queue retryRequest:self afterDelay:delay];
+
+	return YES;
 }
 
--(void)cancelAndError: (NSString*) message {
-    [_connection cancel];
-    [_connection release];
-    _connection = nil;
-    _fails++;
-    if (_fails > 1) {
-        NSMutableDictionary* details = [NSMutableDictionary dictionary];
-        [details setValue:message forKey:NSLocalizedDescriptionKey];
-        // populate the error object with the details
-        NSError* error = [NSError errorWithDomain:@"world" code:200 userInfo:details];
-        [self didFailLoadWithError: error];
-    } else {
-        _isLoading = NO;
-    }
-    
+- (NSObject<RKStreamingParser>*)streamingParserForResponse:(RKResponse*)response {
+	return nil;
+}
+
+- (NSObject<RKResponseBodySink>*)bodySinkForResponse:(RKResponse*)response {
+	if (NO == [response isSuccessful]) {
+		return nil;
+	}
+
+	if (_bodySink) {
+		return _bodySink;
+	}
+
+	return (_downloadsBodyToFile ? [RKResponseFileSink temporaryFileSink] : nil);
+}
+
+- (NSString*)coalescingKey {
+	if (NO == [self isGET] || _params) {
+		return nil;
+	}
+
+	NSMutableString* key = [NSMutableString stringWithFormat:@"%@ %@ %@", NSStringFromClass([self class]), [self HTTPMethod], [_URL absoluteString]];
+	for (NSString* header in [[_additionalHTTPHeaders allKeys] sortedArrayUsingSelector:@selector(compare:)]) {
+		[key appendFormat:@"\n%@: %@", header, [_additionalHTTPHeaders valueForKey:header]];
+	}
+	if (_username) {
+		[key appendFormat:@"\nCredentials: %@", RKRequestCredentialsDigest(_username, _password)];
+	}
+
+	return key;
+}
+
+- (BOOL)addCoalescedRequest:(RKRequest*)request {
+	if (NO == _acceptsCoalescedRequests || _isLoaded) {
+		return NO;
+	}
+
+	if (nil == _coalescedRequests) {
+		_coalescedRequests = [[NSMutableArray alloc] init];
+	}
+	[_coalescedRequests addObject:request];
+	return YES;
+}
+
+- (BOOL)removeCoalescedRequest:(RKRequest*)request {
+	NSUInteger index = [_coalescedRequests indexOfObjectIdenticalTo:request];
+	if (nil == _coalescedRequests || index == NSNotFound) {
+		return NO;
+	}
+
+	[_coalescedRequests removeObjectAtIndex:index];
+	return YES;
+}
+
+- (NSArray*)coalescedRequests {
+	return _coalescedRequests ? [NSArray arrayWithArray:_coalescedRequests] : [NSArray array];
+}
+
+- (NSArray*)takeCoalescedRequests {
+	NSArray* requests = [self coalescedRequests];
+	[_coalescedRequests removeAllObjects];
+	_acceptsCoalescedRequests = NO;
+	return requests;
+}
+
+- (void)cancel {
+	[_connection cancel];
+	[_connection release];
+	_connection = nil;
+	_isLoading = NO;
+	_acceptsCoalescedRequests = YES;
 }
 
 - (void)didFailLoadWithError:(NSError*)error {
 	_isLoading = NO;
 
+	// Requests sharing this connection fail along with it
+	[self retain];
+	for (RKRequest* request in [self takeCoalescedRequests]) {
+		[request didFailLoadWithError:error];
+	}
+	[self autorelease];
+
 	if ([_delegate respondsToSelector:@selector(request:didFailLoadWithError:)]) {
 		[_delegate request:self didFailLoadWithError:error];
 	}
@@ -236,12 +438,21 @@
 	NSDictionary* userInfo = [NSDictionary dictionaryWithObjectsAndKeys:[self HTTPMethod], @"HTTPMethod",
 							  [self URL], @"URL", receivedAt, @"receivedAt", error, @"error", nil];
 	[[NSNotificationCenter defaultCenter] postNotificationName:kRKRequestFailedWithErrorNotification object:self userInfo:userInfo];
+
+	[self didCollectMetricsWithResponse:nil error:error];
 }
 
 - (void)didFinishLoad:(RKResponse*)response {
 	_isLoading = NO;
 	_isLoaded = YES;
 
+	// Requests sharing this connection are finished with the same response
+	[self retain];
+	for (RKRequest* request in [self takeCoalescedRequests]) {
+		[request didFinishLoad:response];
+	}
+	[self autorelease];
+
 	if ([_delegate respondsToSelector:@selector(request:didLoadResponse:)]) {
 		[_delegate request:self didLoadResponse:response];
 	}
@@ -250,7 +461,8 @@
 	NSDictionary* userInfo = [NSDictionary dictionaryWithObjectsAndKeys:[self HTTPMethod], @"HTTPMethod", [self URL], @"URL", receivedAt, @"receivedAt", nil];
 	[[NSNotificationCenter defaultCenter] postNotificationName:kRKResponseReceivedNotification object:response userInfo:userInfo];
 
-	if ([response isServiceUnavailable] && [[RKClient sharedClient] serviceUnavailableAlertEnabled]) {
+	// Requests coalesced into another one leave the alert to the request that loaded the response
+	if ([response isServiceUnavailable] && [[RKClient sharedClient] serviceUnavailableAlertEnabled] && response.request == self) {
 		UIAlertView* alertView = [[UIAlertView alloc] initWithTitle:[[RKClient sharedClient] serviceUnavailableAlertTitle]
 															message:[[RKClient sharedClient] serviceUnavailableAlertMessage]
 														   delegate:nil
@@ -260,6 +472,8 @@
 		[alertView release];
 
 	}
+
+	[self didCollectMetricsWithResponse:response error:nil];
 }
 
 - (BOOL)isGET {
@@ -0,0 +1,101 @@
+//
+//  RKRequestCache.h
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class RKRequest;
+@class RKResponse;
+
+/**
+ * An on-disk cache of GET responses. Entries are keyed by URL plus the values of the request
+ * headers named in the Vary header of the cached response, and hold the status code, headers
+ * and body of the response.
+ *
+ * Requests with a cache revalidate cached entries by sending If-None-Match and
+ * If-Modified-Since. When the server answers 304 Not Modified, the cached response is
+ * handed to the request in place of the empty one, without downloading the body again.
+ *
+ * Only buffered bodies are cached. Responses parsed incrementally while they download keep
+ * no copy of their body and are never stored, so object loaders that parse incrementally
+ * always download their collections in full.
+ */
+@interface RKRequestCache : NSObject {
+	NSString* _cachePath;
+	NSUInteger _maximumDiskSize;
+	unsigned long long _diskSize;
+	BOOL _isDiskSizeKnown;
+}
+
+/**
+ * The directory entries are stored in
+ */
+@property (nonatomic, readonly) NSString* cachePath;
+
+/**
+ * The number of bytes the entries may take up on disk, or 0 for no limit. When storing a
+ * response takes the cache past the limit, the least recently used entries are removed
+ * until it fits again. Entries are used when they are stored or their response is read
+ *
+ * @default 10 MB
+ */
+@property (nonatomic, assign) NSUInteger maximumDiskSize;
+
+/**
+ * The number of bytes the entries take up on disk
+ */
+@property (nonatomic, readonly) unsigned long long diskSize;
+
+/**
+ * Returns the default cache directory, RKRequestCache inside the Caches directory of the application
+ */
++ (NSString*)defaultCachePath;
+
+/**
+ * Initialize a cache storing its entries in the default cache directory
+ */
+- (id)init;
+
+/**
+ * Initialize a cache storing its entries in a directory, which is created if necessary
+ */
+- (id)initWithCachePath:(NSString*)cachePath;
+
+/**
+ * Returns YES when a response to the request is cached
+ */
+- (BOOL)hasResponseForRequest:(RKRequest*)request;
+
+/**
+ * Returns the cached response to the request, or nil. The body is memory mapped from disk
+ */
+- (RKResponse*)responseForRequest:(RKRequest*)request;
+
+/**
+ * Stores a successful response to a GET request. Responses without an ETag or Last-Modified
+ * header cannot be revalidated and are not stored, nor are responses marked no-store or
+ * varying on every header, nor responses without a buffered body
+ */
+- (void)storeResponse:(RKResponse*)response forRequest:(RKRequest*)request;
+
+/**
+ * Sets If-None-Match and If-Modified-Since on the URL request of a GET request with a
+ * cached response, unless the request already sets them
+ */
+- (void)addConditionalHeadersToRequest:(RKRequest*)request;
+
+/**
+ * Removes the cached response to the request
+ */
+- (void)invalidateRequest:(RKRequest*)request;
+
+/**
+ * Removes every cached response
+ */
+- (void)invalidateAll;
+
+@end
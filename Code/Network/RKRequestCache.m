@@ -0,0 +1,286 @@
+//
+//  RKRequestCache.m
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import "RKRequestCache.h"
+#import "RKRequest.h"
+#import "RKResponse.h"
+#import "../Support/RKDigest.h"
+
+static NSString* const kRKRequestCacheStatusCodeKey = @"statusCode";
+static NSString* const kRKRequestCacheMIMETypeKey = @"MIMEType";
+static NSString* const kRKRequestCacheHeadersKey = @"headers";
+static const NSUInteger kRKRequestCacheDefaultMaximumDiskSize = 10 * 1024 * 1024;
+
+// NSHTTPURLResponse changes the case of some header names, so they are compared case insensitively
+static NSString* RKRequestCacheHeaderValue(NSDictionary* headers, NSString* name) {
+	for (NSString* header in headers) {
+		if ([header caseInsensitiveCompare:name] == NSOrderedSame) {
+			return [headers objectForKey:header];
+		}
+	}
+
+	return nil;
+}
+
+@interface RKRequestCache (Private)
+
+- (NSString*)varyPathForRequest:(RKRequest*)request;
+- (NSString*)pathForRequest:(RKRequest*)request extension:(NSString*)extension;
+- (NSDictionary*)infoForRequest:(RKRequest*)request;
+- (void)pruneToMaximumDiskSize;
+
+@end
+
+@implementation RKRequestCache
+
+@synthesize cachePath = _cachePath, maximumDiskSize = _maximumDiskSize;
+
++ (NSString*)defaultCachePath {
+	NSArray* paths = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES);
+	NSString* basePath = ([paths count] > 0) ? [paths objectAtIndex:0] : NSTemporaryDirectory();
+	return [basePath stringByAppendingPathComponent:@"RKRequestCache"];
+}
+
+- (id)init {
+	return [self initWithCachePath:[RKRequestCache defaultCachePath]];
+}
+
+- (id)initWithCachePath:(NSString*)cachePath {
+	if ((self = [super init])) {
+		_cachePath = [cachePath copy];
+		_maximumDiskSize = kRKRequestCacheDefaultMaximumDiskSize;
+		_isDiskSizeKnown = NO;
+		[[NSFileManager defaultManager] createDirectoryAtPath:_cachePath withIntermediateDirectories:YES attributes:nil error:nil];
+	}
+
+	return self;
+}
+
+- (void)dealloc {
+	[_cachePath release];
+	[super dealloc];
+}
+
+// The header names a URL varies on are recorded separately, as they are needed to find the entry
+- (NSString*)varyPathForRequest:(RKRequest*)request {
+	NSString* fileName = [RKMD5HexDigestOfString([[request URL] absoluteString]) stringByAppendingPathExtension:@"vary"];
+	return [_cachePath stringByAppendingPathComponent:fileName];
+}
+
+- (NSString*)pathForRequest:(RKRequest*)request extension:(NSString*)extension {
+	NSMutableString* key = [NSMutableString stringWithString:[[request URL] absoluteString]];
+	for (NSString* header in [NSArray arrayWithContentsOfFile:[self varyPathForRequest:request]]) {
+		NSString* value = [[request URLRequest] valueForHTTPHeaderField:header];
+		[key appendFormat:@"\n%@: %@", [header lowercaseString], value ? value : @""];
+	}
+
+	NSString* fileName = [RKMD5HexDigestOfString(key) stringByAppendingPathExtension:extension];
+	return [_cachePath stringByAppendingPathComponent:fileName];
+}
+
+- (NSDictionary*)infoForRequest:(RKRequest*)request {
+	@synchronized(self) {
+		return [NSDictionary dictionaryWithContentsOfFile:[self pathForRequest:request extension:@"plist"]];
+	}
+}
+
+- (void)setMaximumDiskSize:(NSUInteger)maximumDiskSize {
+	@synchronized(self) {
+		_maximumDiskSize = maximumDiskSize;
+		[self pruneToMaximumDiskSize];
+	}
+}
+
+- (unsigned long long)diskSize {
+	@synchronized(self) {
+		if (NO == _isDiskSizeKnown) {
+			NSFileManager* fileManager = [NSFileManager defaultManager];
+			_diskSize = 0;
+			for (NSString* fileName in [fileManager contentsOfDirectoryAtPath:_cachePath error:nil]) {
+				_diskSize += [[fileManager attributesOfItemAtPath:[_cachePath stringByAppendingPathComponent:fileName] error:nil] fileSize];
+			}
+			_isDiskSizeKnown = YES;
+		}
+
+		return _diskSize;
+	}
+}
+
+// The modification date of an entry's plist records when the entry was last used. Entries are
+// removed oldest first; the small vary files naming the headers of a URL are left in place.
+// Must be called while synchronized on the cache
+- (void)pruneToMaximumDiskSize {
+	if (0 == _maximumDiskSize || [self diskSize] <= _maximumDiskSize) {
+		return;
+	}
+
+	NSFileManager* fileManager = [NSFileManager defaultManager];
+	NSMutableDictionary* entriesByName = [NSMutableDictionary dictionary];
+	_diskSize = 0;
+	for (NSString* fileName in [fileManager contentsOfDirectoryAtPath:_cachePath error:nil]) {
+		NSDictionary* attributes = [fileManager attributesOfItemAtPath:[_cachePath stringByAppendingPathComponent:fileName] error:nil];
+		_diskSize += [attributes fileSize];
+		if ([[fileName pathExtension] isEqualToString:@"vary"]) {
+			continue;
+		}
+
+		NSString* name = [fileName stringByDeletingPathExtension];
+		NSMutableDictionary* entry = [entriesByName objectForKey:name];
+		if (nil == entry) {
+			// A body without a plist is left over from an interrupted store and goes first
+			entry = [NSMutableDictionary dictionaryWithObjectsAndKeys:name, @"name", [NSDate distantPast], @"lastUsed",
+					 [NSNumber numberWithUnsignedLongLong:0], @"size", nil];
+			[entriesByName setObject:entry forKey:name];
+		}
+		unsigned long long size = [[entry objectForKey:@"size"] unsignedLongLongValue] + [attributes fileSize];
+		[entry setObject:[NSNumber numberWithUnsignedLongLong:size] forKey:@"size"];
+		if ([[fileName pathExtension] isEqualToString:@"plist"]) {
+			[entry setObject:[attributes fileModificationDate] forKey:@"lastUsed"];
+		}
+	}
+
+	NSSortDescriptor* sortDescriptor = [[[NSSortDescriptor alloc] initWithKey:@"lastUsed" ascending:YES] autorelease];
+	NSArray* entries = [[entriesByName allValues] sortedArrayUsingDescriptors:[NSArray arrayWithObject:sortDescriptor]];
+	for (NSDictionary* entry in entries) {
+		if (_diskSize <= _maximumDiskSize) {
+			break;
+		}
+
+		NSString* path = [_cachePath stringByAppendingPathComponent:[entry objectForKey:@"name"]];
+		[fileManager removeItemAtPath:[path stringByAppendingPathExtension:@"plist"] error:nil];
+		[fileManager removeItemAtPath:[path stringByAppendingPathExtension:@"body"] error:nil];
+		_diskSize -= [[entry objectForKey:@"size"] unsignedLongLongValue];
+	}
+}
+
+- (BOOL)hasResponseForRequest:(RKRequest*)request {
+	return (nil != [self infoForRequest:request]);
+}
+
+- (RKResponse*)responseForRequest:(RKRequest*)request {
+	NSDictionary* info = nil;
+	NSData* body = nil;
+	@synchronized(self) {
+		info = [self infoForRequest:request];
+		body = [NSData dataWithContentsOfMappedFile:[self pathForRequest:request extension:@"body"]];
+		if (info && body) {
+			NSDictionary* attributes = [NSDictionary dictionaryWithObject:[NSDate date] forKey:NSFileModificationDate];
+			[[NSFileManager defaultManager] setAttributes:attributes ofItemAtPath:[self pathForRequest:request extension:@"plist"] error:nil];
+		}
+	}
+	if (nil == info || nil == body) {
+		return nil;
+	}
+
+	return [[[RKResponse alloc] initWithRequest:request
+									 cachedBody:body
+									 statusCode:[[info objectForKey:kRKRequestCacheStatusCodeKey] integerValue]
+									   MIMEType:[info objectForKey:kRKRequestCacheMIMETypeKey]
+								   headerFields:[info objectForKey:kRKRequestCacheHeadersKey]] autorelease];
+}
+
+- (void)storeResponse:(RKResponse*)response forRequest:(RKRequest*)request {
+	NSData* body = [response body];
+	if (NO == [request isGET] || NO == [response isSuccessful] || nil == body) {
+		return;
+	}
+
+	NSDictionary* headers = [response allHeaderFields];
+	NSString* cacheControl = RKRequestCacheHeaderValue(headers, @"Cache-Control");
+	NSString* vary = [RKRequestCacheHeaderValue(headers, @"Vary") stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+	if ([cacheControl rangeOfString:@"no-store" options:NSCaseInsensitiveSearch].location != NSNotFound || [vary isEqualToString:@"*"]) {
+		return;
+	}
+	if (nil == RKRequestCacheHeaderValue(headers, @"ETag") && nil == RKRequestCacheHeaderValue(headers, @"Last-Modified")) {
+		return;
+	}
+
+	NSMutableArray* varyHeaders = [NSMutableArray array];
+	for (NSString* header in [vary componentsSeparatedByString:@","]) {
+		header = [header stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+		if ([header length] > 0) {
+			[varyHeaders addObject:header];
+		}
+	}
+
+	NSMutableDictionary* info = [NSMutableDictionary dictionary];
+	[info setObject:[NSNumber numberWithInteger:[response statusCode]] forKey:kRKRequestCacheStatusCodeKey];
+	[info setObject:headers forKey:kRKRequestCacheHeadersKey];
+	if ([response MIMEType]) {
+		[info setObject:[response MIMEType] forKey:kRKRequestCacheMIMETypeKey];
+	}
+
+	@synchronized(self) {
+		NSString* varyPath = [self varyPathForRequest:request];
+		if ([varyHeaders count] > 0) {
+			[varyHeaders writeToFile:varyPath atomically:YES];
+		} else {
+			[[NSFileManager defaultManager] removeItemAtPath:varyPath error:nil];
+		}
+
+		// The body is written first so an entry is never visible without it
+		NSFileManager* fileManager = [NSFileManager defaultManager];
+		NSString* bodyPath = [self pathForRequest:request extension:@"body"];
+		NSString* infoPath = [self pathForRequest:request extension:@"plist"];
+		unsigned long long replacedSize = [[fileManager attributesOfItemAtPath:bodyPath error:nil] fileSize] +
+										  [[fileManager attributesOfItemAtPath:infoPath error:nil] fileSize];
+		if ([body writeToFile:bodyPath atomically:YES] && [info writeToFile:infoPath atomically:YES]) {
+			if (_isDiskSizeKnown) {
+				_diskSize = _diskSize - MIN(replacedSize, _diskSize) + [body length] + [[fileManager attributesOfItemAtPath:infoPath error:nil] fileSize];
+			}
+			[self pruneToMaximumDiskSize];
+		} else {
+			_isDiskSizeKnown = NO;
+		}
+	}
+}
+
+- (void)addConditionalHeadersToRequest:(RKRequest*)request {
+	if (NO == [request isGET]) {
+		return;
+	}
+
+	NSDictionary* headers = [[self infoForRequest:request] objectForKey:kRKRequestCacheHeadersKey];
+	NSString* ETag = RKRequestCacheHeaderValue(headers, @"ETag");
+	NSString* lastModified = RKRequestCacheHeaderValue(headers, @"Last-Modified");
+	if (nil == ETag && nil == lastModified) {
+		return;
+	}
+
+	NSMutableURLRequest* URLRequest = [request URLRequest];
+	if (ETag && nil == [URLRequest valueForHTTPHeaderField:@"If-None-Match"]) {
+		[URLRequest setValue:ETag forHTTPHeaderField:@"If-None-Match"];
+	}
+	if (lastModified && nil == [URLRequest valueForHTTPHeaderField:@"If-Modified-Since"]) {
+		[URLRequest setValue:lastModified forHTTPHeaderField:@"If-Modified-Since"];
+	}
+
+	// Keep the URL loading system from answering the revalidation out of its own cache
+	[URLRequest setCachePolicy:NSURLRequestReloadIgnoringLocalCacheData];
+}
+
+- (void)invalidateRequest:(RKRequest*)request {
+	@synchronized(self) {
+		NSFileManager* fileManager = [NSFileManager defaultManager];
+		[fileManager removeItemAtPath:[self pathForRequest:request extension:@"plist"] error:nil];
+		[fileManager removeItemAtPath:[self pathForRequest:request extension:@"body"] error:nil];
+		_isDiskSizeKnown = NO;
+	}
+}
+
+- (void)invalidateAll {
+	@synchronized(self) {
+		NSFileManager* fileManager = [NSFileManager defaultManager];
+		[fileManager removeItemAtPath:_cachePath error:nil];
+		[fileManager createDirectoryAtPath:_cachePath withIntermediateDirectories:YES attributes:nil error:nil];
+		_diskSize = 0;
+		_isDiskSizeKnown = YES;
+	}
+}
+
+@end
@@ -0,0 +1,154 @@
+//
+//  RKRequestMetrics.h
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class RKRequest;
+@class RKRequestMetrics;
+
+/**
+ * Receives the metrics of every request sent with a metrics sink once the request has finished,
+ * on the main thread. Object loaders finish once the objects are mapped and handed to the delegate
+ */
+@protocol RKRequestMetricsSink <NSObject>
+
+- (void)request:(RKRequest*)request didCollectMetrics:(RKRequestMetrics*)metrics;
+
+@end
+
+/**
+ * Timings and transfer sizes of each stage a request passes through, collected while the request
+ * is queued, loaded and, for object loaders, mapped. Times are intervals since the reference date
+ * as returned by [NSDate timeIntervalSinceReferenceDate] and are 0 for stages not reached.
+ *
+ * When a request is retried, the sent, first byte and finish times are those of the last attempt
+ * while transfer sizes and parse time add up over every attempt
+ */
+@interface RKRequestMetrics : NSObject {
+	NSURL* _URL;
+	NSString* _HTTPMethod;
+	NSInteger _statusCode;
+	NSError* _error;
+	NSUInteger _attemptCount;
+	NSTimeInterval _queuedTime;
+	NSTimeInterval _firstSentTime;
+	NSTimeInterval _sentTime;
+	NSTimeInterval _firstByteTime;
+	NSTimeInterval _finishTime;
+	NSTimeInterval _completionTime;
+	long long _bytesSent;
+	long long _bytesReceived;
+	NSTimeInterval _parseDuration;
+	NSTimeInterval _mappingDuration;
+	NSTimeInterval _saveDuration;
+	NSTimeInterval _mergeDuration;
+}
+
+/**
+ * The URL and HTTP method of the request
+ */
+@property (nonatomic, readonly) NSURL* URL;
+@property (nonatomic, readonly) NSString* HTTPMethod;
+
+/**
+ * The status code of the response, or 0 when the request failed without a response
+ */
+@property (nonatomic, assign) NSInteger statusCode;
+
+/**
+ * The error the request failed with, or nil
+ */
+@property (nonatomic, retain) NSError* error;
+
+/**
+ * The number of times the request was sent
+ */
+@property (nonatomic, assign) NSUInteger attemptCount;
+
+/**
+ * When the request was handed to the request queue
+ */
+@property (nonatomic, assign) NSTimeInterval queuedTime;
+
+/**
+ * When the first attempt and the last attempt were sent
+ */
+@property (nonatomic, assign) NSTimeInterval firstSentTime;
+@property (nonatomic, assign) NSTimeInterval sentTime;
+
+/**
+ * When the response headers of the last attempt arrived
+ */
+@property (nonatomic, assign) NSTimeInterval firstByteTime;
+
+/**
+ * When the body of the last attempt finished downloading
+ */
+@property (nonatomic, assign) NSTimeInterval finishTime;
+
+/**
+ * When the request finished, including mapping for object loaders
+ */
+@property (nonatomic, assign) NSTimeInterval completionTime;
+
+/**
+ * The number of body bytes uploaded and downloaded
+ */
+@property (nonatomic, assign) long long bytesSent;
+@property (nonatomic, assign) long long bytesReceived;
+
+/**
+ * The time spent parsing the response body. Bodies parsed incrementally are parsed while they
+ * download. When the object mapper maps collections while parsing them, the parse time is
+ * included in the mapping time instead
+ */
+@property (nonatomic, assign) NSTimeInterval parseDuration;
+
+/**
+ * The time spent mapping the parsed payload into objects
+ */
+@property (nonatomic, assign) NSTimeInterval mappingDuration;
+
+/**
+ * The time spent saving the mapped objects to the managed object store, excluding the merge
+ */
+@property (nonatomic, assign) NSTimeInterval saveDuration;
+
+/**
+ * The time spent merging the saved objects into the managed object context of the main thread.
+ * Only the save of the mapping thread is measured; objects mapped in parallel chunks are saved
+ * together with it rather than on the threads that mapped them
+ */
+@property (nonatomic, assign) NSTimeInterval mergeDuration;
+
+/**
+ * The time between the request being queued and first sent
+ */
+@property (nonatomic, readonly) NSTimeInterval queuedDuration;
+
+/**
+ * The time between the last attempt being sent and its response headers arriving
+ */
+@property (nonatomic, readonly) NSTimeInterval timeToFirstByte;
+
+/**
+ * The time between the response headers of the last attempt arriving and its body finishing
+ */
+@property (nonatomic, readonly) NSTimeInterval downloadDuration;
+
+/**
+ * The time between the request being queued and finishing
+ */
+@property (nonatomic, readonly) NSTimeInterval totalDuration;
+
+/**
+ * Initialize metrics for a request that is about to be queued
+ */
+- (id)initWithRequest:(RKRequest*)request;
+
+@end
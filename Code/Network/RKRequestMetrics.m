@@ -0,0 +1,65 @@
+//
+//  RKRequestMetrics.m
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import "RKRequestMetrics.h"
+#import "RKRequest.h"
+
+// Stages that were not reached count as taking no time
+static NSTimeInterval RKRequestMetricsInterval(NSTimeInterval start, NSTimeInterval end) {
+	return (start > 0 && end > start) ? end - start : 0;
+}
+
+@implementation RKRequestMetrics
+
+@synthesize URL = _URL, HTTPMethod = _HTTPMethod, statusCode = _statusCode, error = _error, attemptCount = _attemptCount,
+			queuedTime = _queuedTime, firstSentTime = _firstSentTime, sentTime = _sentTime, firstByteTime = _firstByteTime,
+			finishTime = _finishTime, completionTime = _completionTime, bytesSent = _bytesSent, bytesReceived = _bytesReceived,
+			parseDuration = _parseDuration, mappingDuration = _mappingDuration, saveDuration = _saveDuration,
+			mergeDuration = _mergeDuration;
+
+- (id)initWithRequest:(RKRequest*)request {
+	if ((self = [super init])) {
+		_URL = [[request URL] retain];
+		_HTTPMethod = [[request HTTPMethod] copy];
+		_queuedTime = [NSDate timeIntervalSinceReferenceDate];
+	}
+
+	return self;
+}
+
+- (void)dealloc {
+	[_URL release];
+	[_HTTPMethod release];
+	[_error release];
+	[super dealloc];
+}
+
+- (NSTimeInterval)queuedDuration {
+	return RKRequestMetricsInterval(_queuedTime, _firstSentTime);
+}
+
+- (NSTimeInterval)timeToFirstByte {
+	return RKRequestMetricsInterval(_sentTime, _firstByteTime);
+}
+
+- (NSTimeInterval)downloadDuration {
+	return RKRequestMetricsInterval(_firstByteTime, _finishTime);
+}
+
+- (NSTimeInterval)totalDuration {
+	return RKRequestMetricsInterval(_queuedTime, _completionTime);
+}
+
+- (NSString*)description {
+	return [NSString stringWithFormat:@"<%@: %@ %@ status=%ld attempts=%lu queued=%.3fs ttfb=%.3fs download=%.3fs parse=%.3fs mapping=%.3fs save=%.3fs merge=%.3fs total=%.3fs sent=%lld received=%lld>",
+			NSStringFromClass([self class]), _HTTPMethod, [_URL absoluteString], (long)_statusCode, (unsigned long)_attemptCount, [self queuedDuration],
+			[self timeToFirstByte], [self downloadDuration], _parseDuration, _mappingDuration, _saveDuration, _mergeDuration,
+			[self totalDuration], _bytesSent, _bytesReceived];
+}
+
+@end
@@ -14,8 +14,19 @@
  * for dispatching and managing RKRequest objects
  */
 @interface RKRequestQueue : NSObject {
-	NSMutableArray* _requests;
-	NSInteger		_totalLoading;
+	NSMutableSet*	_requests;
+	NSArray*		_pendingRequestsByPriority;
+	NSArray*		_pendingHostsByPriority;
+	NSUInteger		_pendingCount;
+	NSMutableSet*	_loadingRequests;
+	NSCountedSet*	_loadingRequestsByHost;
+	NSMutableSet*	_loadingBackgroundRequests;
+	NSUInteger		_maxConcurrentRequests;
+	NSUInteger		_maxConcurrentRequestsPerHost;
+	NSUInteger		_maxConcurrentBackgroundRequests;
+	NSMutableSet*	_retryingRequests;
+	NSMutableDictionary* _requestsByCoalescingKey;
+	BOOL			_coalescesRequests;
 	NSTimer*        _queueTimer;
 	BOOL			_suspended;
 }
@@ -29,6 +40,50 @@
  */
 @property (nonatomic) BOOL suspended;
 
+/**
+ * The maximum number of requests loading at once across all hosts
+ *
+ * @default 5
+ */
+@property (nonatomic, assign) NSUInteger maxConcurrentRequests;
+
+/**
+ * The maximum number of requests loading at once from a single host
+ *
+ * @default 4
+ */
+@property (nonatomic, assign) NSUInteger maxConcurrentRequestsPerHost;
+
+/**
+ * The maximum number of RKRequestPriorityBackground requests loading at once. Background
+ * requests also never take the last free slot of the global or per host limits, so a
+ * large background sync always leaves room for interactive requests
+ *
+ * @default 2
+ */
+@property (nonatomic, assign) NSUInteger maxConcurrentBackgroundRequests;
+
+/**
+ * When YES, a request sent while an identical request is queued or loading shares the other
+ * request's connection instead of opening its own. Object loaders also share the mapped objects,
+ * so the response is mapped once. Every delegate is informed of the outcome, but the response
+ * handed to the delegates of coalesced requests is the one loaded for the other request, so its
+ * request property is not the request the delegate sent. See RKRequest coalescingKey
+ *
+ * @default NO
+ */
+@property (nonatomic, assign) BOOL coalescesRequests;
+
+/**
+ * The number of requests currently loading
+ */
+@property (nonatomic, readonly) NSUInteger loadingCount;
+
+/**
+ * The number of requests waiting to be dispatched
+ */
+@property (nonatomic, readonly) NSUInteger pendingCount;
+
 /**
  * Return the global queue
  */
@@ -41,10 +96,20 @@
 
 /**
  * Add an asynchronous request to the queue and send it as
- * as soon as possible
+ * as soon as possible. Pending requests are dispatched in order of
+ * priority. Within a priority, requests to the same host are dispatched
+ * in the order they were sent and hosts take turns
  */
 - (void)sendRequest:(RKRequest*)request;
 
+/**
+ * Sends a request that is loading again once the delay has passed. The request gives up its
+ * place among the loading requests while it waits, and is then queued again at its priority.
+ * Identical requests sent in the meantime are coalesced into it. Invoked by requests whose
+ * retry policy decided to send them again
+ */
+- (void)retryRequest:(RKRequest*)request afterDelay:(NSTimeInterval)delay;
+
 /**
  * Cancel a request that is in progress
  */
@@ -15,11 +15,49 @@ static RKRequestQueue* gSharedQueue = nil;
 
 static const NSTimeInterval kFlushDelay = 0.3;
 static const NSTimeInterval kTimeout = 300.0;
-static const NSInteger kMaxConcurrentLoads = 5;
+static const NSUInteger kMaxConcurrentLoads = 5;
+static const NSUInteger kMaxConcurrentLoadsPerHost = 4;
+static const NSUInteger kMaxConcurrentBackgroundLoads = 2;
+
+// Lanes are drained in this order
+static const RKRequestPriority kRKRequestQueueDispatchOrder[RKRequestPriorityCount] = {
+	RKRequestPriorityInteractive,
+	RKRequestPriorityDefault,
+	RKRequestPriorityBackground
+};
+
+static NSUInteger RKRequestQueueDispatchRank(RKRequestPriority priority) {
+	NSUInteger rank;
+	for (rank = 0; rank < RKRequestPriorityCount; rank++) {
+		if (kRKRequestQueueDispatchOrder[rank] == priority) {
+			break;
+		}
+	}
+
+	return rank;
+}
+
+@interface RKRequestQueue (Private)
+
+- (NSString*)hostForRequest:(RKRequest*)request;
+- (BOOL)canDispatchFromLane:(RKRequestPriority)priority;
+- (BOOL)canDispatchToHost:(NSString*)host fromLane:(RKRequestPriority)priority;
+- (RKRequest*)dequeueNextDispatchableRequestWithPriority:(RKRequestPriority*)priority;
+- (void)enqueuePendingRequest:(RKRequest*)request;
+- (void)removePendingRequest:(RKRequest*)request;
+- (void)removeRequest:(RKRequest*)request;
+- (BOOL)coalesceRequest:(RKRequest*)request;
+- (void)resendRetryingRequest:(RKRequest*)request;
+
+@end
 
 @implementation RKRequestQueue
 
 @synthesize suspended = _suspended;
+@synthesize maxConcurrentRequests = _maxConcurrentRequests;
+@synthesize maxConcurrentRequestsPerHost = _maxConcurrentRequestsPerHost;
+@synthesize maxConcurrentBackgroundRequests = _maxConcurrentBackgroundRequests;
+@synthesize coalescesRequests = _coalescesRequests;
 
 + (RKRequestQueue*)sharedQueue {
 	if (!gSharedQueue) {
@@ -37,9 +75,27 @@ static const NSInteger kMaxConcurrentLoads = 5;
 
 - (id)init {
 	if ((self = [super init])) {
-		_requests = [[NSMutableArray alloc] init];
+		_requests = [[NSMutableSet alloc] init];
+		NSMutableArray* lanes = [NSMutableArray arrayWithCapacity:RKRequestPriorityCount];
+		NSMutableArray* hosts = [NSMutableArray arrayWithCapacity:RKRequestPriorityCount];
+		NSUInteger i;
+		for (i = 0; i < RKRequestPriorityCount; i++) {
+			[lanes addObject:[NSMutableDictionary dictionary]];
+			[hosts addObject:[NSMutableArray array]];
+		}
+		_pendingRequestsByPriority = [lanes copy];
+		_pendingHostsByPriority = [hosts copy];
+		_pendingCount = 0;
+		_loadingRequests = [[NSMutableSet alloc] init];
+		_loadingRequestsByHost = [[NSCountedSet alloc] init];
+		_loadingBackgroundRequests = [[NSMutableSet alloc] init];
+		_retryingRequests = [[NSMutableSet alloc] init];
+		_maxConcurrentRequests = kMaxConcurrentLoads;
+		_maxConcurrentRequestsPerHost = kMaxConcurrentLoadsPerHost;
+		_maxConcurrentBackgroundRequests = kMaxConcurrentBackgroundLoads;
+		_requestsByCoalescingKey = [[NSMutableDictionary alloc] init];
+		_coalescesRequests = NO;
 		_suspended = NO;
-		_totalLoading = 0;
 		[[NSNotificationCenter defaultCenter] addObserver:self
 												 selector:@selector(responseDidLoad:)
 													 name:kRKResponseReceivedNotification
@@ -53,9 +109,22 @@ static const NSInteger kMaxConcurrentLoads = 5;
 }
 
 - (void)dealloc {
+	[[NSNotificationCenter defaultCenter] removeObserver:self];
 	[_queueTimer invalidate];
+	for (RKRequest* request in _requests) {
+		if (request.queue == self) {
+			request.queue = nil;
+		}
+	}
 	[_requests release];
 	_requests = nil;
+	[_pendingRequestsByPriority release];
+	[_pendingHostsByPriority release];
+	[_loadingRequests release];
+	[_loadingRequestsByHost release];
+	[_loadingBackgroundRequests release];
+	[_retryingRequests release];
+	[_requestsByCoalescingKey release];
 	[super dealloc];
 }
 
@@ -69,29 +138,201 @@ static const NSInteger kMaxConcurrentLoads = 5;
 	}
 }
 
-- (void)dispatchRequest:(RKRequest*)request {
+- (NSUInteger)loadingCount {
+	return [_loadingRequests count];
+}
+
+- (NSUInteger)pendingCount {
+	return _pendingCount;
+}
+
+- (NSString*)hostForRequest:(RKRequest*)request {
+	NSString* host = [[[request URL] host] lowercaseString];
+	return host ? host : @"";
+}
+
+// Background requests leave the last slot of each limit free for more urgent requests. The priority
+// is that of the lane holding the request, which is what the request is accounted under once loading
+- (BOOL)canDispatchFromLane:(RKRequestPriority)priority {
+	BOOL isBackground = (priority == RKRequestPriorityBackground);
+	NSUInteger reserved = isBackground ? 1 : 0;
+	if (isBackground && [_loadingBackgroundRequests count] >= _maxConcurrentBackgroundRequests) {
+		return NO;
+	}
+
+	return [_loadingRequests count] + reserved < MAX(_maxConcurrentRequests, 1 + reserved);
+}
+
+- (BOOL)canDispatchToHost:(NSString*)host fromLane:(RKRequestPriority)priority {
+	NSUInteger reserved = (priority == RKRequestPriorityBackground) ? 1 : 0;
+	return [_loadingRequestsByHost countForObject:host] + reserved < MAX(_maxConcurrentRequestsPerHost, 1 + reserved);
+}
+
+// The request counts against the background limit for as long as it loads, even when its
+// priority is changed in the meantime
+- (void)dispatchRequest:(RKRequest*)request withPriority:(RKRequestPriority)priority {
+	[_loadingRequests addObject:request];
+	[_loadingRequestsByHost addObject:[self hostForRequest:request]];
+	if (priority == RKRequestPriorityBackground) {
+		[_loadingBackgroundRequests addObject:request];
+	}
+	request.queue = self;
+	
 	[request performSelector:@selector(fireAsynchronousRequest)];
 }
 
+// Each lane holds a FIFO of pending requests per host and the hosts with pending requests in
+// the order they take turns. A lane is skipped outright when its global limits are reached, so
+// a host is only passed over when it already has a request loading. The scan of a lane therefore
+// stops after at most maxConcurrentRequests hosts, however many hosts and requests are pending
+- (RKRequest*)dequeueNextDispatchableRequestWithPriority:(RKRequestPriority*)priority {
+	if ([_loadingRequests count] >= _maxConcurrentRequests) {
+		return nil;
+	}
+
+	NSUInteger i;
+	for (i = 0; i < RKRequestPriorityCount; i++) {
+		RKRequestPriority lane = kRKRequestQueueDispatchOrder[i];
+		NSMutableDictionary* requestsByHost = [_pendingRequestsByPriority objectAtIndex:lane];
+		NSMutableArray* hosts = [_pendingHostsByPriority objectAtIndex:lane];
+		if ([hosts count] == 0 || NO == [self canDispatchFromLane:lane]) {
+			continue;
+		}
+
+		NSUInteger j;
+		for (j = 0; j < [hosts count]; j++) {
+			NSString* host = [hosts objectAtIndex:j];
+			if (NO == [self canDispatchToHost:host fromLane:lane]) {
+				continue;
+			}
+
+			NSMutableArray* requests = [requestsByHost objectForKey:host];
+			RKRequest* request = [requests objectAtIndex:0];
+			[[request retain] autorelease];
+			[[host retain] autorelease];
+			[requests removeObjectAtIndex:0];
+			[hosts removeObjectAtIndex:j];
+			if ([requests count] > 0) {
+				[hosts addObject:host];
+			} else {
+				[requestsByHost removeObjectForKey:host];
+			}
+			_pendingCount--;
+			*priority = lane;
+
+			return request;
+		}
+	}
+
+	return nil;
+}
+
+- (void)removeLoadingRequest:(RKRequest*)request {
+	[_loadingRequests removeObject:request];
+	[_loadingRequestsByHost removeObject:[self hostForRequest:request]];
+	[_loadingBackgroundRequests removeObject:request];
+}
+
+// Forgets a request that has finished or been cancelled, whether it was loading, waiting to be retried or pending
+- (void)removeRequest:(RKRequest*)request {
+	if ([_loadingRequests containsObject:request]) {
+		[self removeLoadingRequest:request];
+	} else if ([_retryingRequests containsObject:request]) {
+		[NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(resendRetryingRequest:) object:request];
+		[_retryingRequests removeObject:request];
+	} else {
+		[self removePendingRequest:request];
+	}
+	if (request.queue == self) {
+		request.queue = nil;
+	}
+
+	NSString* key = [request coalescingKey];
+	if (key && [_requestsByCoalescingKey objectForKey:key] == request) {
+		[_requestsByCoalescingKey removeObjectForKey:key];
+	}
+	
+	[_requests removeObject:request];
+}
+
+- (void)enqueuePendingRequest:(RKRequest*)request {
+	RKRequestPriority priority = request.priority < RKRequestPriorityCount ? request.priority : RKRequestPriorityDefault;
+	NSString* host = [self hostForRequest:request];
+	NSMutableDictionary* requestsByHost = [_pendingRequestsByPriority objectAtIndex:priority];
+	NSMutableArray* requests = [requestsByHost objectForKey:host];
+	if (nil == requests) {
+		requests = [NSMutableArray array];
+		[requestsByHost setObject:requests forKey:host];
+		[[_pendingHostsByPriority objectAtIndex:priority] addObject:host];
+	}
+	[requests addObject:request];
+	_pendingCount++;
+}
+
+- (void)removePendingRequest:(RKRequest*)request {
+	NSString* host = [self hostForRequest:request];
+	NSUInteger i;
+	for (i = 0; i < RKRequestPriorityCount; i++) {
+		NSMutableDictionary* requestsByHost = [_pendingRequestsByPriority objectAtIndex:i];
+		NSMutableArray* requests = [requestsByHost objectForKey:host];
+		NSUInteger index = [requests indexOfObjectIdenticalTo:request];
+		if (requests && index != NSNotFound) {
+			[requests removeObjectAtIndex:index];
+			if ([requests count] == 0) {
+				[requestsByHost removeObjectForKey:host];
+				[[_pendingHostsByPriority objectAtIndex:i] removeObject:host];
+			}
+			_pendingCount--;
+			break;
+		}
+	}
+}
+
+// Attaches the request to an identical one that is already queued or loading. A pending request
+// is promoted to the priority of the most urgent request attached to it
+- (BOOL)coalesceRequest:(RKRequest*)request {
+	NSString* key = _coalescesRequests ? [request coalescingKey] : nil;
+	RKRequest* coalescingRequest = key ? [_requestsByCoalescingKey objectForKey:key] : nil;
+	if (nil == coalescingRequest || coalescingRequest == request || NO == [coalescingRequest addCoalescedRequest:request]) {
+		if (key) {
+			[_requestsByCoalescingKey setObject:request forKey:key];
+		}
+		return NO;
+	}
+
+	if (NO == [_loadingRequests containsObject:coalescingRequest] &&
+		RKRequestQueueDispatchRank(request.priority) < RKRequestQueueDispatchRank(coalescingRequest.priority)) {
+		[self removePendingRequest:coalescingRequest];
+		coalescingRequest.priority = request.priority;
+		[self enqueuePendingRequest:coalescingRequest];
+	}
+
+	return YES;
+}
+
 - (void)loadNextInQueue {
+	if (_suspended) {
+		return;
+	}
+
 	// This makes sure that the Request Queue does not fire off any requests until the Reachability state has been determined.
-	// This prevents the request queue from
+	// The queue is otherwise driven by requests being sent and finishing, so this is the only case that polls
 	if ([[[RKClient sharedClient] baseURLReachabilityObserver] networkStatus] == RKReachabilityIndeterminate) {
-		[self loadNextInQueueDelayed];
+		if (_pendingCount > 0) {
+			[self loadNextInQueueDelayed];
+		}
 		return;
 	}
 
+	[_queueTimer invalidate];
 	_queueTimer = nil;
 
-	for (RKRequest* request in _requests) {
-		if (![request isLoading] && ![request isLoaded] && _totalLoading < kMaxConcurrentLoads) {
-			++_totalLoading;
-			[self dispatchRequest:request];
-		}
-	}
-
-	if (_requests.count && !_suspended) {
-		[self loadNextInQueueDelayed];
+	// Requests are dequeued before they are dispatched, so a request that finishes synchronously
+	// and re-enters the queue can never be dispatched twice
+	RKRequest* request = nil;
+	RKRequestPriority priority;
+	while (!_suspended && (request = [self dequeueNextDispatchableRequestWithPriority:&priority])) {
+		[self dispatchRequest:request withPriority:priority];
 	}
 }
 
@@ -107,17 +348,65 @@ static const NSInteger kMaxConcurrentLoads = 5;
 }
 
 - (void)sendRequest:(RKRequest*)request {
-	[_requests addObject:request];
+	if ([_requests containsObject:request]) {
+		return;
+	}
+
+	if (NO == [self coalesceRequest:request]) {
+		[_requests addObject:request];
+		[self enqueuePendingRequest:request];
+	}
+
+	[self loadNextInQueue];
+}
+
+- (void)retryRequest:(RKRequest*)request afterDelay:(NSTimeInterval)delay {
+	if ([_loadingRequests containsObject:request]) {
+		[self removeLoadingRequest:request];
+	} else if (NO == [_requests containsObject:request]) {
+		[_requests addObject:request];
+	}
+
+	[_retryingRequests addObject:request];
+	[self performSelector:@selector(resendRetryingRequest:) withObject:request afterDelay:delay];
+
+	// The slot given up by the request goes to the next pending one
+	[self loadNextInQueue];
+}
+
+- (void)resendRetryingRequest:(RKRequest*)request {
+	if (NO == [_retryingRequests containsObject:request]) {
+		return;
+	}
+
+	[_retryingRequests removeObject:request];
+	[self enqueuePendingRequest:request];
 	[self loadNextInQueue];
 }
 
 - (void)cancelRequest:(RKRequest*)request loadNext:(BOOL)loadNext {
-	if ([_requests containsObject:request] && ![request isLoaded]) {
+	if (NO == [_requests containsObject:request]) {
+		// A coalesced request only has to be detached from the request loading on its behalf
+		NSString* key = [request coalescingKey];
+		RKRequest* coalescingRequest = key ? [_requestsByCoalescingKey objectForKey:key] : nil;
+		if ([coalescingRequest removeCoalescedRequest:request]) {
+			request.delegate = nil;
+		}
+	} else if (![request isLoaded]) {
+		[[request retain] autorelease];
+		NSArray* coalescedRequests = [request takeCoalescedRequests];
 		[request cancel];
 		request.delegate = nil;
 
-		[_requests removeObject:request];
-		_totalLoading--;
+		[self removeRequest:request];
+
+		// Requests that were sharing the cancelled connection carry on without it
+		for (RKRequest* coalescedRequest in coalescedRequests) {
+			if (NO == [self coalesceRequest:coalescedRequest]) {
+				[_requests addObject:coalescedRequest];
+				[self enqueuePendingRequest:coalescedRequest];
+			}
+		}
 
 		if (loadNext) {
 			[self loadNextInQueue];
@@ -130,8 +419,13 @@ static const NSInteger kMaxConcurrentLoads = 5;
 }
 
 - (void)cancelRequestsWithDelegate:(NSObject<RKRequestDelegate>*)delegate {
-	NSArray* requestsCopy = [NSArray arrayWithArray:_requests];
+	NSArray* requestsCopy = [_requests allObjects];
 	for (RKRequest* request in requestsCopy) {
+		for (RKRequest* coalescedRequest in [request coalescedRequests]) {
+			if (coalescedRequest.delegate && coalescedRequest.delegate == delegate) {
+				[self cancelRequest:coalescedRequest];
+			}
+		}
 		if (request.delegate && request.delegate == delegate) {
 			[self cancelRequest:request];
 		}
@@ -139,8 +433,11 @@ static const NSInteger kMaxConcurrentLoads = 5;
 }
 
 - (void)cancelAllRequests {
-	NSArray* requestsCopy = [NSArray arrayWithArray:_requests];
+	NSArray* requestsCopy = [_requests allObjects];
 	for (RKRequest* request in requestsCopy) {
+		for (RKRequest* coalescedRequest in [request coalescedRequests]) {
+			[self cancelRequest:coalescedRequest loadNext:NO];
+		}
 		[self cancelRequest:request loadNext:NO];
 	}
 }
@@ -154,14 +451,12 @@ static const NSInteger kMaxConcurrentLoads = 5;
 		// Our RKRequest completed and we're notified with an RKResponse object
 		if ([notification.object isKindOfClass:[RKResponse class]]) {
 			RKRequest* request = [(RKResponse*)notification.object request];
-			[_requests removeObject:request];
-			_totalLoading--;
+			[self removeRequest:request];
 
 		// Our RKRequest failed and we're notified with the original RKRequest object
 		} else if ([notification.object isKindOfClass:[RKRequest class]]) {
 			RKRequest* request = (RKRequest*)notification.object;
-			[_requests removeObject:request];
-			_totalLoading--;
+			[self removeRequest:request];
 		}
 
 		[self loadNextInQueue];
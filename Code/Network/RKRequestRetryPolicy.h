@@ -0,0 +1,111 @@
+//
+//  RKRequestRetryPolicy.h
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "RKRequest.h"
+
+/**
+ * Decides whether a request that failed or loaded a transient error response is sent again,
+ * and how long to wait before doing so. Attempts are spaced by an exponentially growing backoff
+ * with random jitter, so clients failing at the same moment do not retry in lockstep.
+ *
+ * Only requests sent with a method the policy retries are sent again. By default these are the
+ * idempotent methods GET, PUT and DELETE; POST must be enabled explicitly
+ */
+@interface RKRequestRetryPolicy : NSObject {
+	NSUInteger _maxAttempts;
+	NSTimeInterval _initialBackoffInterval;
+	NSTimeInterval _maximumBackoffInterval;
+	double _backoffMultiplier;
+	double _jitter;
+	NSSet* _retryableStatusCodes;
+	NSSet* _retryableURLErrorCodes;
+	BOOL _retriesMethods[4];
+}
+
+/**
+ * The number of times a request is sent at most, including the first attempt
+ *
+ * @default 3
+ */
+@property (nonatomic, assign) NSUInteger maxAttempts;
+
+/**
+ * The delay before the second attempt
+ *
+ * @default 0.5
+ */
+@property (nonatomic, assign) NSTimeInterval initialBackoffInterval;
+
+/**
+ * The factor the delay grows by with each further attempt
+ *
+ * @default 2.0
+ */
+@property (nonatomic, assign) double backoffMultiplier;
+
+/**
+ * The longest delay before an attempt, including delays requested with a Retry-After header
+ *
+ * @default 30
+ */
+@property (nonatomic, assign) NSTimeInterval maximumBackoffInterval;
+
+/**
+ * The fraction of each delay that is randomized, between 0 and 1. A jitter of 0.5 waits
+ * between half and all of the backoff interval
+ *
+ * @default 0.5
+ */
+@property (nonatomic, assign) double jitter;
+
+/**
+ * NSNumbers of the HTTP status codes of responses that are retried
+ *
+ * @default 408, 502, 503 and 504
+ */
+@property (nonatomic, retain) NSSet* retryableStatusCodes;
+
+/**
+ * NSNumbers of the NSURLErrorDomain error codes of failed connections that are retried
+ *
+ * @default NSURLErrorTimedOut, NSURLErrorCannotFindHost, NSURLErrorCannotConnectToHost,
+ * NSURLErrorNetworkConnectionLost and NSURLErrorDNSLookupFailed
+ */
+@property (nonatomic, retain) NSSet* retryableURLErrorCodes;
+
+/**
+ * Return an auto-released policy with the default settings
+ */
++ (id)defaultPolicy;
+
+/**
+ * Returns YES when requests sent with the method are retried
+ */
+- (BOOL)retriesMethod:(RKRequestMethod)method;
+
+/**
+ * Sets whether requests sent with the method are retried. Only enable this for POST when the
+ * server is known to handle the same POST arriving twice
+ */
+- (void)setRetriesMethod:(BOOL)retriesMethod forMethod:(RKRequestMethod)method;
+
+/**
+ * Returns YES when the request should be sent again after its latest attempt loaded the
+ * response or failed with the error
+ */
+- (BOOL)shouldRetryRequest:(RKRequest*)request response:(RKResponse*)response error:(NSError*)error;
+
+/**
+ * Returns the time to wait before sending the request again after its latest attempt loaded
+ * the response or failed with an error, in which case response is nil. A Retry-After header
+ * in seconds is honoured when it asks for a longer delay than the backoff
+ */
+- (NSTimeInterval)delayBeforeRetryingRequest:(RKRequest*)request response:(RKResponse*)response;
+
+@end
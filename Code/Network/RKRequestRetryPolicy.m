@@ -0,0 +1,89 @@
+//
+//  RKRequestRetryPolicy.m
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import "RKRequestRetryPolicy.h"
+#import "RKResponse.h"
+
+@implementation RKRequestRetryPolicy
+
+@synthesize maxAttempts = _maxAttempts, initialBackoffInterval = _initialBackoffInterval, backoffMultiplier = _backoffMultiplier,
+			maximumBackoffInterval = _maximumBackoffInterval, jitter = _jitter, retryableStatusCodes = _retryableStatusCodes,
+			retryableURLErrorCodes = _retryableURLErrorCodes;
+
++ (id)defaultPolicy {
+	return [[[self alloc] init] autorelease];
+}
+
+- (id)init {
+	if ((self = [super init])) {
+		_maxAttempts = 3;
+		_initialBackoffInterval = 0.5;
+		_backoffMultiplier = 2.0;
+		_maximumBackoffInterval = 30;
+		_jitter = 0.5;
+		_retryableStatusCodes = [[NSSet alloc] initWithObjects:[NSNumber numberWithInteger:408], [NSNumber numberWithInteger:502],
+								 [NSNumber numberWithInteger:503], [NSNumber numberWithInteger:504], nil];
+		_retryableURLErrorCodes = [[NSSet alloc] initWithObjects:[NSNumber numberWithInteger:NSURLErrorTimedOut],
+								   [NSNumber numberWithInteger:NSURLErrorCannotFindHost],
+								   [NSNumber numberWithInteger:NSURLErrorCannotConnectToHost],
+								   [NSNumber numberWithInteger:NSURLErrorNetworkConnectionLost],
+								   [NSNumber numberWithInteger:NSURLErrorDNSLookupFailed], nil];
+		_retriesMethods[RKRequestMethodGET] = YES;
+		_retriesMethods[RKRequestMethodPOST] = NO;
+		_retriesMethods[RKRequestMethodPUT] = YES;
+		_retriesMethods[RKRequestMethodDELETE] = YES;
+	}
+
+	return self;
+}
+
+- (void)dealloc {
+	[_retryableStatusCodes release];
+	[_retryableURLErrorCodes release];
+	[super dealloc];
+}
+
+- (BOOL)retriesMethod:(RKRequestMethod)method {
+	return (method <= RKRequestMethodDELETE && _retriesMethods[method]);
+}
+
+- (void)setRetriesMethod:(BOOL)retriesMethod forMethod:(RKRequestMethod)method {
+	if (method <= RKRequestMethodDELETE) {
+		_retriesMethods[method] = retriesMethod;
+	}
+}
+
+- (BOOL)shouldRetryRequest:(RKRequest*)request response:(RKResponse*)response error:(NSError*)error {
+	if (request.attemptCount >= _maxAttempts || NO == [self retriesMethod:request.method]) {
+		return NO;
+	}
+
+	if (error) {
+		return ([[error domain] isEqualToString:NSURLErrorDomain] && [_retryableURLErrorCodes containsObject:[NSNumber numberWithInteger:[error code]]]);
+	}
+
+	return [_retryableStatusCodes containsObject:[NSNumber numberWithInteger:[response statusCode]]];
+}
+
+- (NSTimeInterval)delayBeforeRetryingRequest:(RKRequest*)request response:(RKResponse*)response {
+	NSUInteger retry = (request.attemptCount > 0 ? request.attemptCount - 1 : 0);
+	NSTimeInterval backoff = MIN(_initialBackoffInterval * pow(_backoffMultiplier, retry), _maximumBackoffInterval);
+	double jitter = MAX(0.0, MIN(_jitter, 1.0));
+	NSTimeInterval delay = backoff * (1.0 - jitter * ((double)arc4random() / UINT32_MAX));
+
+	// Only the delta-seconds form of Retry-After is understood; HTTP dates are ignored
+	NSString* retryAfter = [[response allHeaderFields] objectForKey:@"Retry-After"];
+	if (retryAfter) {
+		NSTimeInterval requestedDelay = [retryAfter doubleValue];
+		delay = MAX(delay, MIN(requestedDelay, _maximumBackoffInterval));
+	}
+
+	return delay;
+}
+
+@end
@@ -34,7 +34,8 @@
 
 /**
  * Returns an input stream for reading the serialization as a stream. Used to provide support for
- * handling large HTTP payloads.
+ * handling large HTTP payloads. Implementations that also implement HTTPBody may return nil to
+ * have the body sent from HTTPBody instead.
  */
 - (NSInputStream*)HTTPBodyStream;
 
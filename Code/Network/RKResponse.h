@@ -8,14 +8,23 @@
 
 #import <Foundation/Foundation.h>
 #import "RKRequest.h"
+#import "../Support/RKParser.h"
 
 @interface RKResponse : NSObject {
 	RKRequest* _request;
 	NSHTTPURLResponse* _httpURLResponse;
 	NSMutableData* _body;
+	NSMutableArray* _bodyChunks;
 	NSError* _failureError;
+	NSObject<RKStreamingParser>* _bodyParser;
+	NSObject<RKResponseBodySink>* _bodySink;
+	NSData* _sinkBody;
 	BOOL _loading;
-    NSTimer* _loadTimer;
+	NSData* _cachedBody;
+	NSInteger _cachedStatusCode;
+	NSString* _cachedMIMEType;
+	NSDictionary* _cachedHeaderFields;
+	BOOL _wasLoadedFromCache;
 }
 
 /**
@@ -44,10 +53,24 @@
 @property(nonatomic, readonly) NSDictionary* allHeaderFields;
 
 /**
- * The data returned as the response body
+ * The data returned as the response body. When the body was written to a sink, this is the
+ * data of the sink, which is memory mapped for file sinks. Bodies parsed incrementally are
+ * handed to the parser as they arrive and are not kept, so body is empty for those responses
  */
 @property(nonatomic, readonly) NSData* body;
 
+/**
+ * The payload assembled while the body was downloading, or nil if the body was buffered
+ * or could not be parsed. When the request supplies a streaming parser for the response,
+ * received data is handed straight to the parser and is not accumulated into body.
+ */
+@property(nonatomic, readonly) id parsedBody;
+
+/**
+ * The error the body was rejected with while it was parsed incrementally, or nil
+ */
+@property(nonatomic, readonly) NSError* parseError;
+
 /**
  * The error returned if the URL connection fails
  */
@@ -68,13 +91,24 @@
  */
 - (id)initWithSynchronousRequest:(RKRequest*)request URLResponse:(NSURLResponse*)URLResponse body:(NSData*)body error:(NSError*)error;
 
+/**
+ * Initializes a response object from a response stored in an RKRequestCache
+ */
+- (id)initWithRequest:(RKRequest*)request cachedBody:(NSData*)body statusCode:(NSInteger)statusCode MIMEType:(NSString*)MIMEType headerFields:(NSDictionary*)headerFields;
+
+/**
+ * Returns YES when this response was read from the request cache after the server reported
+ * that the resource was not modified
+ */
+- (BOOL)wasLoadedFromCache;
+
 /**
  * Return the localized human readable representation of the HTTP Status Code returned
  */
 - (NSString*)localizedStatusCodeString;
 
 /**
- * Return the response body as an NSString
+ * Return the response body as an NSString. Empty for responses parsed incrementally
  */
 - (NSString*)bodyAsString;
 
@@ -83,6 +117,16 @@
  */
 - (id)bodyAsJSON;
 
+/**
+ * Returns YES when the body was parsed incrementally as it downloaded
+ */
+- (BOOL)wasParsedIncrementally;
+
+/**
+ * The sink the body was written to as it downloaded, or nil if the body was buffered
+ */
+- (NSObject<RKResponseBodySink>*)bodySink;
+
 /**
  * Will determine if there is an error object and use it's localized message
  */
@@ -9,15 +9,26 @@
 #import "RKResponse.h"
 #import "RKNotifications.h"
 #import "RKJSONParser.h"
+#import "RKRequestCache.h"
+#import "../Support/Errors.h"
 #define NSLog(__FORMAT__, ...) TFLog((@"%s [Line %d] " __FORMAT__), __PRETTY_FUNCTION__, __LINE__, ##__VA_ARGS__)
 
+// Larger Content-Length values are not trusted to size the body buffer up front
+static const long long kRKResponseMaximumPreallocatedLength = 32 * 1024 * 1024;
+
+@interface RKResponse (Private)
+
+- (void)prepareBodyForURLResponse:(NSHTTPURLResponse*)response;
+
+@end
+
 @implementation RKResponse
 
-@synthesize body = _body, request = _request, failureError = _failureError;
+@synthesize request = _request, failureError = _failureError;
 
 - (id)init {
 	if (self = [super init]) {
-		_body = [[NSMutableData alloc] init];
+		_bodyChunks = [[NSMutableArray alloc] init];
 		_failureError = nil;
 		_loading = NO;
 	}
@@ -30,9 +41,7 @@
 		// We don't retain here as we're letting RKRequestQueue manage
 		// request ownership
 		_request = request;
-        _loading = NO;
-        _loadTimer = [NSTimer scheduledTimerWithTimeInterval: 5.0 target:self selector:@selector(timerTick) userInfo:nil repeats: NO];
-        [_loadTimer retain];
+		_loading = NO;
 	}
 
 	return self;
@@ -47,33 +56,35 @@
 		_failureError = [error retain];
 		_body = [body retain];
 		_loading = NO;
-        _loadTimer = [NSTimer scheduledTimerWithTimeInterval: 5.0 target:self selector:@selector(timerTick) userInfo:nil repeats: NO];
-        [_loadTimer retain];
-
 	}
 
 	return self;
 }
 
--(void) timerTick {
-    if (!_loading) {
-        NSLog(@"Got Request Timer Tick and have not loaded, so cancelling");
-        if ([_request.HTTPMethod isEqualToString:@"GET"]) {
-            NSLog(@"This is a GET request so I'll keep waiting...");
-        } else {
-            [_request cancelAndError: @"timeout trying to connect"];
-        }
-    } else {
-        NSLog(@"Got Request Timer Tick and already loading so all good");
-    }
+- (id)initWithRequest:(RKRequest*)request cachedBody:(NSData*)body statusCode:(NSInteger)statusCode MIMEType:(NSString*)MIMEType headerFields:(NSDictionary*)headerFields {
+	if ((self = [self init])) {
+		_request = request;
+		_cachedBody = [body retain];
+		_cachedStatusCode = statusCode;
+		_cachedMIMEType = [MIMEType copy];
+		_cachedHeaderFields = [headerFields retain];
+		_wasLoadedFromCache = YES;
+	}
+
+	return self;
 }
 
 - (void)dealloc {
 	[_httpURLResponse release];
 	[_body release];
+	[_bodyChunks release];
 	[_failureError release];
-    [_loadTimer invalidate];
-    [_loadTimer release];
+	[_bodyParser release];
+	[_bodySink release];
+	[_sinkBody release];
+	[_cachedBody release];
+	[_cachedMIMEType release];
+	[_cachedHeaderFields release];
 	[super dealloc];
 }
 
@@ -94,30 +105,119 @@
 - (void)dispatchRequestDidStartLoadIfNecessary {
 	if (NO == _loading) {
         _loading = YES;
-		if ([[_request delegate] respondsToSelector:@selector(requestDidStartLoad:)]) {
+		// Retried requests only announce their first attempt
+		if ([_request attemptCount] <= 1 && [[_request delegate] respondsToSelector:@selector(requestDidStartLoad:)]) {
 			[[_request delegate] requestDidStartLoad:_request];
 		}
 	}
 }
 
 - (void)connection:(NSURLConnection *)connection didReceiveData:(NSData *)data {
-	[_body appendData:data];
+	RKRequestMetrics* metrics = _request.metrics;
+	metrics.bytesReceived += [data length];
+	if (_bodyParser) {
+		// Parse errors are surfaced once the load completes
+		NSTimeInterval parseStartTime = [NSDate timeIntervalSinceReferenceDate];
+		[_bodyParser parseData:data];
+		metrics.parseDuration += [NSDate timeIntervalSinceReferenceDate] - parseStartTime;
+	} else if (_bodySink) {
+		if (NO == [_bodySink writeData:data]) {
+			[connection cancel];
+			// The request must not fail without an error, even when the sink does not explain itself
+			NSError* error = [_bodySink error];
+			if (nil == error) {
+				NSDictionary* userInfo = [NSDictionary dictionaryWithObject:@"The response body could not be written to its sink"
+																	 forKey:NSLocalizedDescriptionKey];
+				error = [NSError errorWithDomain:RKRestKitErrorDomain code:RKResponseBodySinkError userInfo:userInfo];
+			}
+			[self connection:connection didFailWithError:error];
+		}
+	} else if (_bodyChunks) {
+		// Chunks are only joined once the body is asked for, so the buffer is never regrown
+		[_bodyChunks addObject:[[data copy] autorelease]];
+	} else {
+		[_body appendData:data];
+	}
+}
+
+// The buffer is sized once from a Content-Length that matches the bytes we will be handed.
+// The URL loading system decodes gzip and deflate bodies, so encoded lengths are not used.
+// Bodies handed to a streaming parser or a sink are never buffered, so they get no capacity
+- (void)prepareBodyForURLResponse:(NSHTTPURLResponse*)response {
+	[_body release];
+	_body = nil;
+	[_bodyChunks release];
+	_bodyChunks = nil;
+	if (_bodyParser || _bodySink) {
+		_body = [[NSMutableData alloc] init];
+		return;
+	}
+
+	long long expectedLength = [response expectedContentLength];
+	NSString* contentEncoding = [[response allHeaderFields] objectForKey:@"Content-Encoding"];
+	BOOL isIdentityEncoded = (nil == contentEncoding || [contentEncoding caseInsensitiveCompare:@"identity"] == NSOrderedSame);
+	if (isIdentityEncoded && expectedLength > 0 && expectedLength <= kRKResponseMaximumPreallocatedLength) {
+		_body = [[NSMutableData alloc] initWithCapacity:(NSUInteger)expectedLength];
+	} else {
+		_bodyChunks = [[NSMutableArray alloc] init];
+	}
 }
 
 - (void)connection:(NSURLConnection *)connection didReceiveResponse:(NSHTTPURLResponse *)response {
 	[self dispatchRequestDidStartLoadIfNecessary];
+	_request.metrics.firstByteTime = [NSDate timeIntervalSinceReferenceDate];
+	[_httpURLResponse release];
 	_httpURLResponse = [response retain];
+
+	[_bodyParser release];
+	_bodyParser = [[_request streamingParserForResponse:self] retain];
+	[_bodySink release];
+	_bodySink = (_bodyParser ? nil : [[_request bodySinkForResponse:self] retain]);
+	[self prepareBodyForURLResponse:response];
 }
 
 - (void)connectionDidFinishLoading:(NSURLConnection *)connection {
+	RKRequestMetrics* metrics = _request.metrics;
+	NSTimeInterval finishTime = [NSDate timeIntervalSinceReferenceDate];
+	metrics.finishTime = finishTime;
+	if (_bodyParser && NO == [_bodyParser finishParsing]) {
+		NSLog(@"Encountered error: %@ incrementally parsing response body", _bodyParser.error);
+	}
+	if (_bodyParser) {
+		metrics.parseDuration += [NSDate timeIntervalSinceReferenceDate] - finishTime;
+	}
+	[_bodySink finishWriting];
+
+	// The connection may release us once the request abandons the attempt
+	[[self retain] autorelease];
+	if ([_request retryAfterResponse:self error:nil]) {
+		return;
+	}
+
+	// A revalidated GET finishes with the cached response in place of the empty 304
+	RKRequestCache* cache = _request.cache;
+	if (cache && [_request isGET]) {
+		RKResponse* cachedResponse = ([self statusCode] == 304) ? [cache responseForRequest:_request] : nil;
+		if (cachedResponse) {
+			[_request didFinishLoad:cachedResponse];
+			return;
+		} else if (NO == [self wasParsedIncrementally]) {
+			[cache storeResponse:self forRequest:_request];
+		}
+	}
+
 	[_request didFinishLoad:self];
-     [_loadTimer invalidate];
 }
 
 - (void)connection:(NSURLConnection *)connection didFailWithError:(NSError *)error {
+	[[self retain] autorelease];
+	if ([_request retryAfterResponse:self error:error]) {
+		return;
+	}
+
+	[_failureError release];
 	_failureError = [error retain];
 	[_request didFailLoadWithError:_failureError];
-    [_loadTimer invalidate];
 }
 
 // In the event that the url request is a post, this delegate method will be called before
@@ -128,7 +228,8 @@
 // callbacks get called in the correct order.
 - (void)connection:(NSURLConnection *)connection didSendBodyData:(NSInteger)bytesWritten totalBytesWritten:(NSInteger)totalBytesWritten totalBytesExpectedToWrite:(NSInteger)totalBytesExpectedToWrite {
 	[self dispatchRequestDidStartLoadIfNecessary];
-	
+	_request.metrics.bytesSent += bytesWritten;
+
 	if ([[_request delegate] respondsToSelector:@selector(request:didSendBodyData:totalBytesWritten:totalBytesExpectedToWrite:)]) {
 		[[_request delegate] request:_request didSendBodyData:bytesWritten totalBytesWritten:totalBytesWritten totalBytesExpectedToWrite:totalBytesExpectedToWrite];
 	}
@@ -143,7 +244,53 @@
 }
 
 - (id)bodyAsJSON {
-	return [[[[RKJSONParser alloc] init] autorelease] objectFromString:[self bodyAsString]];
+	return [[[[RKJSONParser alloc] init] autorelease] objectFromData:self.body];
+}
+
+- (NSData*)body {
+	if (_wasLoadedFromCache) {
+		return _cachedBody;
+	} else if (_bodySink) {
+		if (nil == _sinkBody) {
+			_sinkBody = [[_bodySink data] retain];
+		}
+		return _sinkBody;
+	} else if (_bodyChunks) {
+		NSUInteger length = 0;
+		for (NSData* chunk in _bodyChunks) {
+			length += [chunk length];
+		}
+
+		[_body release];
+		_body = [[NSMutableData alloc] initWithCapacity:length];
+		for (NSData* chunk in _bodyChunks) {
+			[_body appendData:chunk];
+		}
+		[_bodyChunks release];
+		_bodyChunks = nil;
+	}
+
+	return _body;
+}
+
+- (NSObject<RKResponseBodySink>*)bodySink {
+	return _bodySink;
+}
+
+- (BOOL)wasLoadedFromCache {
+	return _wasLoadedFromCache;
+}
+
+- (id)parsedBody {
+	return (_bodyParser.error ? nil : _bodyParser.result);
+}
+
+- (NSError*)parseError {
+	return _bodyParser.error;
+}
+
+- (BOOL)wasParsedIncrementally {
+	return (nil != _bodyParser);
 }
 
 - (NSString*)failureErrorDescription {
@@ -155,19 +302,19 @@
 }
 
 - (NSURL*)URL {
-	return [_httpURLResponse URL];
+	return (_wasLoadedFromCache ? [_request URL] : [_httpURLResponse URL]);
 }
 
 - (NSString*)MIMEType {
-	return [_httpURLResponse MIMEType];
+	return (_wasLoadedFromCache ? _cachedMIMEType : [_httpURLResponse MIMEType]);
 }
 
 - (NSInteger)statusCode {
-	return [_httpURLResponse statusCode];
+	return (_wasLoadedFromCache ? _cachedStatusCode : [_httpURLResponse statusCode]);
 }
 
 - (NSDictionary*)allHeaderFields {
-	return [_httpURLResponse allHeaderFields];
+	return (_wasLoadedFromCache ? _cachedHeaderFields : [_httpURLResponse allHeaderFields]);
 }
 
 - (NSArray*)cookies {
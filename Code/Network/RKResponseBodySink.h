@@ -0,0 +1,40 @@
+//
+//  RKResponseBodySink.h
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * This protocol is implemented by objects that consume a response body as it downloads in place
+ * of the response accumulating it in memory. See RKResponseFileSink for a sink writing the body
+ * to a file.
+ */
+@protocol RKResponseBodySink <NSObject>
+
+/**
+ * Consumes the next chunk of the body. Returning NO fails the request with the error of the sink
+ */
+- (BOOL)writeData:(NSData*)data;
+
+/**
+ * Signals that the entire body has been received
+ */
+- (void)finishWriting;
+
+/**
+ * The body consumed by the sink, or nil if the sink does not retain it. Only requested once
+ * writing has finished
+ */
+- (NSData*)data;
+
+/**
+ * The error that made writeData: return NO. When nil, the request fails with an
+ * RKResponseBodySinkError in the RestKit error domain
+ */
+- (NSError*)error;
+
+@end
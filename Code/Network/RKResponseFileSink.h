@@ -0,0 +1,46 @@
+//
+//  RKResponseFileSink.h
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "RKResponseBodySink.h"
+
+/**
+ * Writes a response body to a file as it downloads and exposes the result as memory mapped data,
+ * so a large body never occupies memory as a whole
+ */
+@interface RKResponseFileSink : NSObject <RKResponseBodySink> {
+	NSString* _filePath;
+	NSOutputStream* _outputStream;
+	NSError* _error;
+	BOOL _removesFile;
+}
+
+/**
+ * The file the body is written to
+ */
+@property (nonatomic, readonly) NSString* filePath;
+
+/**
+ * When YES, the file is removed once the sink is deallocated. Data mapped from the file
+ * remains readable after it has been removed. Move the file elsewhere to keep it instead
+ *
+ * @default YES for temporary files, NO otherwise
+ */
+@property (nonatomic, assign) BOOL removesFile;
+
+/**
+ * Return an auto-released sink writing to a new file in the temporary directory
+ */
++ (id)temporaryFileSink;
+
+/**
+ * Initialize a sink writing to a file, which is replaced if it exists
+ */
+- (id)initWithFilePath:(NSString*)filePath;
+
+@end
@@ -0,0 +1,92 @@
+//
+//  RKResponseFileSink.m
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import "RKResponseFileSink.h"
+
+@implementation RKResponseFileSink
+
+@synthesize filePath = _filePath, removesFile = _removesFile;
+
++ (id)temporaryFileSink {
+	CFUUIDRef UUID = CFUUIDCreate(kCFAllocatorDefault);
+	NSString* fileName = (NSString*)CFUUIDCreateString(kCFAllocatorDefault, UUID);
+	CFRelease(UUID);
+
+	NSString* filePath = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSString stringWithFormat:@"RKResponse-%@", fileName]];
+	[fileName release];
+
+	RKResponseFileSink* sink = [[[self alloc] initWithFilePath:filePath] autorelease];
+	sink.removesFile = YES;
+	return sink;
+}
+
+- (id)initWithFilePath:(NSString*)filePath {
+	if ((self = [super init])) {
+		_filePath = [filePath copy];
+		_removesFile = NO;
+	}
+
+	return self;
+}
+
+- (void)dealloc {
+	[_outputStream close];
+	[_outputStream release];
+	if (_removesFile) {
+		[[NSFileManager defaultManager] removeItemAtPath:_filePath error:nil];
+	}
+	[_filePath release];
+	[_error release];
+	[super dealloc];
+}
+
+- (BOOL)writeData:(NSData*)data {
+	// The file is only created once the body starts arriving
+	if (nil == _outputStream) {
+		_outputStream = [[NSOutputStream alloc] initToFileAtPath:_filePath append:NO];
+		[_outputStream open];
+	}
+
+	const uint8_t* bytes = [data bytes];
+	NSUInteger length = [data length];
+	while (length > 0) {
+		NSInteger bytesWritten = [_outputStream write:bytes maxLength:length];
+		if (bytesWritten <= 0) {
+			[_error release];
+			_error = [[_outputStream streamError] retain];
+			NSLog(@"[RestKit] RKResponseFileSink: Failed writing to %@: %@", _filePath, _error);
+			return NO;
+		}
+
+		bytes += bytesWritten;
+		length -= bytesWritten;
+	}
+
+	return YES;
+}
+
+- (void)finishWriting {
+	if (nil == _outputStream) {
+		// An empty body still produces a file
+		[[NSData data] writeToFile:_filePath atomically:NO];
+	}
+
+	[_outputStream close];
+	[_outputStream release];
+	_outputStream = nil;
+}
+
+- (NSData*)data {
+	return [NSData dataWithContentsOfMappedFile:_filePath];
+}
+
+- (NSError*)error {
+	return _error;
+}
+
+@end
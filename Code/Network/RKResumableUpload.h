@@ -0,0 +1,151 @@
+//
+//  RKResumableUpload.h
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "RKRequest.h"
+#import "RKParamsAttachment.h"
+
+@class RKClient;
+@protocol RKResumableUploadDelegate;
+
+/**
+ * Uploads a file attachment as a series of PUT requests, one per byte range, so an interrupted
+ * upload picks up where it left off instead of starting over.
+ *
+ * Each request carries a Content-Range header and an X-Upload-ID header identifying the upload.
+ * The server answers 308 Resume Incomplete with a Range header naming the bytes it has stored,
+ * and a 2xx status once it has the whole file. Before resuming, the upload asks the server what
+ * it has by sending a request without a body whose Content-Range names only the total length.
+ *
+ * The upload ID and the confirmed length are persisted on disk, keyed by the URL and the path,
+ * size and modification date of the file. Sending an upload for the same file to the same URL
+ * after a failure or a relaunch resumes from the last confirmed byte.
+ */
+@interface RKResumableUpload : NSObject <RKRequestDelegate> {
+	RKClient* _client;
+	NSString* _resourcePath;
+	RKParamsAttachment* _attachment;
+	NSObject<RKResumableUploadDelegate>* _delegate;
+	NSString* _statePath;
+	NSString* _uploadID;
+	NSData* _fileData;
+	RKRequest* _request;
+	NSUInteger _fileLength;
+	NSUInteger _confirmedLength;
+	NSUInteger _chunkSize;
+	NSUInteger _retryLimit;
+	NSUInteger _failureCount;
+	NSTimeInterval _retryInterval;
+	BOOL _isUploading;
+}
+
+/**
+ * The resource path the file is uploaded to
+ */
+@property (nonatomic, readonly) NSString* resourcePath;
+
+/**
+ * The file attachment being uploaded
+ */
+@property (nonatomic, readonly) RKParamsAttachment* attachment;
+
+/**
+ * The delegate informed of the progress and the outcome of the upload
+ */
+@property (nonatomic, assign) NSObject<RKResumableUploadDelegate>* delegate;
+
+/**
+ * The number of bytes sent per request
+ *
+ * @default 256KB
+ */
+@property (nonatomic, assign) NSUInteger chunkSize;
+
+/**
+ * The number of consecutive failed requests tolerated before the upload gives up and
+ * informs the delegate. Sending the upload again resumes it
+ *
+ * @default 3
+ */
+@property (nonatomic, assign) NSUInteger retryLimit;
+
+/**
+ * The delay before the first retry. Each subsequent retry waits an additional interval
+ *
+ * @default 2 seconds
+ */
+@property (nonatomic, assign) NSTimeInterval retryInterval;
+
+/**
+ * The number of bytes of the file the server has confirmed storing
+ */
+@property (nonatomic, readonly) NSUInteger confirmedLength;
+
+/**
+ * YES while requests are being sent for the upload
+ */
+@property (nonatomic, readonly) BOOL isUploading;
+
+/**
+ * Returns the directory the state of uploads is persisted in, RKResumableUploads inside
+ * the Caches directory of the application. The state of uploads that made no progress for
+ * a week is removed when an upload is created
+ */
++ (NSString*)defaultStatePath;
+
+/**
+ * Return an auto-released upload of a file attachment to a resource path of a client
+ */
++ (id)uploadWithResourcePath:(NSString*)resourcePath attachment:(RKParamsAttachment*)attachment client:(RKClient*)client delegate:(NSObject<RKResumableUploadDelegate>*)delegate;
+
+/**
+ * Initialize an upload of a file attachment to a resource path of a client. Attachments of
+ * values and data cannot be uploaded this way
+ */
+- (id)initWithResourcePath:(NSString*)resourcePath attachment:(RKParamsAttachment*)attachment client:(RKClient*)client delegate:(NSObject<RKResumableUploadDelegate>*)delegate;
+
+/**
+ * Starts the upload, or resumes it from the last byte confirmed by the server
+ */
+- (void)send;
+
+/**
+ * Stops sending requests. The persisted state is kept, so the upload can be resumed later
+ */
+- (void)cancel;
+
+/**
+ * Stops sending requests and forgets the persisted state, so the next upload of the file starts over
+ */
+- (void)discard;
+
+@end
+
+/**
+ * Lifecycle events for RKResumableUploads
+ */
+@protocol RKResumableUploadDelegate
+
+/**
+ * Sent when the server has stored the whole file
+ */
+- (void)upload:(RKResumableUpload*)upload didFinishWithResponse:(RKResponse*)response;
+
+/**
+ * Sent when the upload failed. Sending the upload again resumes it, unless the server rejected it
+ */
+- (void)upload:(RKResumableUpload*)upload didFailWithError:(NSError*)error;
+
+@optional
+
+/**
+ * Sent whenever the server confirms storing more of the file
+ */
+- (void)upload:(RKResumableUpload*)upload didConfirmLength:(NSUInteger)confirmedLength ofLength:(NSUInteger)length;
+
+@end
@@ -0,0 +1,344 @@
+//
+//  RKResumableUpload.m
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import "RKResumableUpload.h"
+#import "RKClient.h"
+#import "RKResponse.h"
+#import "RKRequestQueue.h"
+#import "../Support/Errors.h"
+#import "../Support/RKDigest.h"
+
+static NSString* const kRKResumableUploadIDKey = @"uploadID";
+static NSString* const kRKResumableUploadConfirmedLengthKey = @"confirmedLength";
+
+// The status servers answer with while an upload is incomplete
+static const NSInteger kRKResumableUploadIncompleteStatusCode = 308;
+
+// The state of uploads that made no progress for this long is discarded, as servers expire them too
+static const NSTimeInterval kRKResumableUploadStateMaximumAge = 7 * 24 * 60 * 60;
+
+// Removes the persisted state of uploads that were abandoned, so the directory does not grow forever
+static void RKResumableUploadRemoveStaleStates(NSString* statePath) {
+	NSFileManager* fileManager = [NSFileManager defaultManager];
+	NSDate* expiryDate = [NSDate dateWithTimeIntervalSinceNow:-kRKResumableUploadStateMaximumAge];
+	for (NSString* fileName in [fileManager contentsOfDirectoryAtPath:statePath error:nil]) {
+		if (NO == [[fileName pathExtension] isEqualToString:@"plist"]) {
+			continue;
+		}
+
+		NSString* path = [statePath stringByAppendingPathComponent:fileName];
+		NSDate* modificationDate = [[fileManager attributesOfItemAtPath:path error:nil] objectForKey:NSFileModificationDate];
+		if (modificationDate && [modificationDate compare:expiryDate] == NSOrderedAscending) {
+			[fileManager removeItemAtPath:path error:nil];
+		}
+	}
+}
+
+/**
+ * The body of a request carrying one byte range of the file. The range is sent straight
+ * out of the memory mapped file
+ */
+@interface RKResumableUploadChunk : NSObject <RKRequestSerializable> {
+	NSData* _fileData;
+	NSRange _range;
+	NSString* _MIMEType;
+}
+
+- (id)initWithFileData:(NSData*)fileData range:(NSRange)range MIMEType:(NSString*)MIMEType;
+
+@end
+
+@implementation RKResumableUploadChunk
+
+- (id)initWithFileData:(NSData*)fileData range:(NSRange)range MIMEType:(NSString*)MIMEType {
+	if ((self = [super init])) {
+		_fileData = [fileData retain];
+		_range = range;
+		_MIMEType = [MIMEType copy];
+	}
+
+	return self;
+}
+
+- (void)dealloc {
+	[_fileData release];
+	[_MIMEType release];
+	[super dealloc];
+}
+
+- (NSString*)HTTPHeaderValueForContentType {
+	return _MIMEType ? _MIMEType : @"application/octet-stream";
+}
+
+// The chunk retains the file data, which outlives the request body pointing into it
+- (NSData*)HTTPBody {
+	return [NSData dataWithBytesNoCopy:(void*)((const uint8_t*)[_fileData bytes] + _range.location) length:_range.length freeWhenDone:NO];
+}
+
+@end
+
+@interface RKResumableUpload (Private)
+
+- (void)loadState;
+- (void)saveState;
+- (void)removeState;
+- (void)startOver;
+- (void)confirmLength;
+- (void)sendNextChunk;
+- (void)sendRequestWithContentRange:(NSString*)contentRange params:(NSObject<RKRequestSerializable>*)params;
+- (void)stopSendingRequests;
+- (void)didConfirmLengthInResponse:(RKResponse*)response;
+- (void)didFailWithError:(NSError*)error canResume:(BOOL)canResume;
+
+@end
+
+@implementation RKResumableUpload
+
+@synthesize resourcePath = _resourcePath, attachment = _attachment, delegate = _delegate, chunkSize = _chunkSize,
+			retryLimit = _retryLimit, retryInterval = _retryInterval, confirmedLength = _confirmedLength,
+			isUploading = _isUploading;
+
++ (NSString*)defaultStatePath {
+	NSArray* paths = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES);
+	NSString* basePath = ([paths count] > 0) ? [paths objectAtIndex:0] : NSTemporaryDirectory();
+	return [basePath stringByAppendingPathComponent:@"RKResumableUploads"];
+}
+
++ (id)uploadWithResourcePath:(NSString*)resourcePath attachment:(RKParamsAttachment*)attachment client:(RKClient*)client delegate:(NSObject<RKResumableUploadDelegate>*)delegate {
+	return [[[self alloc] initWithResourcePath:resourcePath attachment:attachment client:client delegate:delegate] autorelease];
+}
+
+- (id)initWithResourcePath:(NSString*)resourcePath attachment:(RKParamsAttachment*)attachment client:(RKClient*)client delegate:(NSObject<RKResumableUploadDelegate>*)delegate {
+	NSAssert(nil != attachment.filePath, @"Only file attachments can be uploaded in byte ranges");
+	if ((self = [super init])) {
+		_resourcePath = [resourcePath copy];
+		_attachment = [attachment retain];
+		_client = [client retain];
+		_delegate = delegate;
+		_chunkSize = 256 * 1024;
+		_retryLimit = 3;
+		_retryInterval = 2.0;
+
+		// Uploads are identified by the file as well as its destination, so a modified file starts over
+		NSString* filePath = attachment.filePath;
+		NSDictionary* attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:filePath error:nil];
+		NSString* key = [NSString stringWithFormat:@"%@\n%@\n%@\n%@", [client URLPathForResourcePath:resourcePath], filePath,
+						 [attributes objectForKey:NSFileSize], [attributes objectForKey:NSFileModificationDate]];
+		NSString* statePath = [RKResumableUpload defaultStatePath];
+		[[NSFileManager defaultManager] createDirectoryAtPath:statePath withIntermediateDirectories:YES attributes:nil error:nil];
+		RKResumableUploadRemoveStaleStates(statePath);
+		_statePath = [[statePath stringByAppendingPathComponent:[RKMD5HexDigestOfString(key) stringByAppendingPathExtension:@"plist"]] retain];
+		[self loadState];
+	}
+
+	return self;
+}
+
+- (void)dealloc {
+	[self stopSendingRequests];
+	[_resourcePath release];
+	[_attachment release];
+	[_client release];
+	[_statePath release];
+	[_uploadID release];
+	[_fileData release];
+	[super dealloc];
+}
+
+#pragma mark State
+
+- (void)loadState {
+	NSDictionary* state = [NSDictionary dictionaryWithContentsOfFile:_statePath];
+	[_uploadID release];
+	_uploadID = [[state objectForKey:kRKResumableUploadIDKey] retain];
+	_confirmedLength = [[state objectForKey:kRKResumableUploadConfirmedLengthKey] unsignedIntegerValue];
+}
+
+- (void)saveState {
+	NSDictionary* state = [NSDictionary dictionaryWithObjectsAndKeys:_uploadID, kRKResumableUploadIDKey,
+						   [NSNumber numberWithUnsignedInteger:_confirmedLength], kRKResumableUploadConfirmedLengthKey, nil];
+	[state writeToFile:_statePath atomically:YES];
+}
+
+- (void)removeState {
+	[[NSFileManager defaultManager] removeItemAtPath:_statePath error:nil];
+}
+
+// Begins a new upload of the file under a new upload ID
+- (void)startOver {
+	CFUUIDRef UUID = CFUUIDCreate(kCFAllocatorDefault);
+	[_uploadID release];
+	_uploadID = (NSString*)CFUUIDCreateString(kCFAllocatorDefault, UUID);
+	CFRelease(UUID);
+	_confirmedLength = 0;
+	[self saveState];
+}
+
+#pragma mark Sending
+
+- (void)send {
+	if (_isUploading) {
+		return;
+	}
+
+	[_fileData release];
+	_fileData = [[_attachment body] retain];
+	if (nil == _fileData) {
+		NSString* errorMessage = [NSString stringWithFormat:@"The file at %@ could not be read", _attachment.filePath];
+		NSDictionary* userInfo = [NSDictionary dictionaryWithObject:errorMessage forKey:NSLocalizedDescriptionKey];
+		[self didFailWithError:[NSError errorWithDomain:RKRestKitErrorDomain code:RKResumableUploadRejectedError userInfo:userInfo] canResume:NO];
+		return;
+	}
+
+	_fileLength = [_fileData length];
+	_failureCount = 0;
+	_isUploading = YES;
+	if (_uploadID) {
+		// The server may have stored more than it confirmed before the upload was interrupted
+		[self confirmLength];
+	} else {
+		[self startOver];
+		[self sendNextChunk];
+	}
+}
+
+- (void)confirmLength {
+	[self sendRequestWithContentRange:[NSString stringWithFormat:@"bytes */%lu", (unsigned long)_fileLength] params:nil];
+}
+
+- (void)sendNextChunk {
+	if (_fileLength == 0) {
+		[self confirmLength];
+		return;
+	}
+
+	NSRange range = NSMakeRange(_confirmedLength, MIN(_chunkSize, _fileLength - _confirmedLength));
+	RKResumableUploadChunk* chunk = [[RKResumableUploadChunk alloc] initWithFileData:_fileData range:range MIMEType:_attachment.MIMEType];
+	[self sendRequestWithContentRange:[NSString stringWithFormat:@"bytes %lu-%lu/%lu", (unsigned long)range.location, (unsigned long)(NSMaxRange(range) - 1), (unsigned long)_fileLength] params:chunk];
+	[chunk release];
+}
+
+- (void)sendRequestWithContentRange:(NSString*)contentRange params:(NSObject<RKRequestSerializable>*)params {
+	[_request release];
+	_request = [[_client requestWithResourcePath:_resourcePath delegate:self] retain];
+	_request.method = RKRequestMethodPUT;
+	_request.params = params;
+	// Failed chunks are retried by confirming the length the server holds instead
+	_request.retryPolicy = nil;
+
+	NSMutableDictionary* headers = [NSMutableDictionary dictionaryWithDictionary:_request.additionalHTTPHeaders];
+	[headers setObject:contentRange forKey:@"Content-Range"];
+	[headers setObject:_uploadID forKey:@"X-Upload-ID"];
+	NSString* fileName = _attachment.fileName ? _attachment.fileName : [_attachment.filePath lastPathComponent];
+	[headers setObject:[NSString stringWithFormat:@"form-data; name=\"%@\"; filename=\"%@\"", _attachment.name, fileName] forKey:@"Content-Disposition"];
+	_request.additionalHTTPHeaders = headers;
+
+	[_request send];
+}
+
+- (void)stopSendingRequests {
+	[NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(confirmLength) object:nil];
+	if (_request) {
+		_request.delegate = nil;
+		[[RKRequestQueue sharedQueue] cancelRequest:_request];
+		[_request release];
+		_request = nil;
+	}
+	_isUploading = NO;
+}
+
+- (void)cancel {
+	[self stopSendingRequests];
+}
+
+- (void)discard {
+	[self stopSendingRequests];
+	[self removeState];
+	[_uploadID release];
+	_uploadID = nil;
+	_confirmedLength = 0;
+}
+
+#pragma mark Responses
+
+// A 308 names the bytes stored as a Range of bytes=0-last. Without a Range nothing has been stored
+- (void)didConfirmLengthInResponse:(RKResponse*)response {
+	NSString* range = [[response allHeaderFields] objectForKey:@"Range"];
+	NSUInteger confirmedLength = 0;
+	NSRange separator = [range rangeOfString:@"-"];
+	if (separator.location != NSNotFound) {
+		confirmedLength = [[range substringFromIndex:NSMaxRange(separator)] integerValue] + 1;
+	}
+
+	_confirmedLength = MIN(confirmedLength, _fileLength);
+	_failureCount = 0;
+	[self saveState];
+
+	if ([_delegate respondsToSelector:@selector(upload:didConfirmLength:ofLength:)]) {
+		[_delegate upload:self didConfirmLength:_confirmedLength ofLength:_fileLength];
+	}
+}
+
+- (void)didFailWithError:(NSError*)error canResume:(BOOL)canResume {
+	[self stopSendingRequests];
+	if (NO == canResume) {
+		[self discard];
+	}
+
+	[_delegate upload:self didFailWithError:error];
+}
+
+- (void)request:(RKRequest*)request didLoadResponse:(RKResponse*)response {
+	BOOL wasConfirmingLength = (nil == request.params);
+	[[_request retain] autorelease];
+	[_request release];
+	_request = nil;
+
+	if ([response statusCode] == kRKResumableUploadIncompleteStatusCode) {
+		[self didConfirmLengthInResponse:response];
+		// The delegate may have cancelled the upload when informed of the progress
+		if (_isUploading) {
+			[self sendNextChunk];
+		}
+	} else if ([response isSuccessful]) {
+		_confirmedLength = _fileLength;
+		_isUploading = NO;
+		[self removeState];
+		[_delegate upload:self didFinishWithResponse:response];
+	} else if (wasConfirmingLength && ([response statusCode] == 404 || [response statusCode] == 410)) {
+		// The server no longer knows the upload, so it is sent again from the start
+		[self startOver];
+		[self sendNextChunk];
+	} else if ([response isServerError]) {
+		NSDictionary* userInfo = [NSDictionary dictionaryWithObject:[NSString stringWithFormat:@"The server failed with status %ld", (long)[response statusCode]]
+															 forKey:NSLocalizedDescriptionKey];
+		[self request:request didFailLoadWithError:[NSError errorWithDomain:RKRestKitErrorDomain code:RKResumableUploadRejectedError userInfo:userInfo]];
+	} else {
+		NSDictionary* userInfo = [NSDictionary dictionaryWithObject:[NSString stringWithFormat:@"The server rejected the upload with status %ld", (long)[response statusCode]]
+															 forKey:NSLocalizedDescriptionKey];
+		[self didFailWithError:[NSError errorWithDomain:RKRestKitErrorDomain code:RKResumableUploadRejectedError userInfo:userInfo] canResume:NO];
+	}
+}
+
+// Failed requests are retried after asking the server how much of the file it has stored
+- (void)request:(RKRequest*)request didFailLoadWithError:(NSError*)error {
+	[[_request retain] autorelease];
+	[_request release];
+	_request = nil;
+
+	_failureCount++;
+	if (_failureCount > _retryLimit) {
+		NSLog(@"[RestKit] RKResumableUpload: Giving up on upload %@ after %lu failures: %@", _uploadID, (unsigned long)_failureCount, error);
+		[self didFailWithError:error canResume:YES];
+		return;
+	}
+
+	[self performSelector:@selector(confirmLength) withObject:nil afterDelay:_retryInterval * _failureCount];
+}
+
+@end
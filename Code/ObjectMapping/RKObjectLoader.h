@@ -50,6 +50,8 @@
 	RKManagedObjectStore* _managedObjectStore;
 	NSManagedObjectID* _targetObjectID;
 	RKClient* _client;
+	BOOL _parsesIncrementally;
+	BOOL _mapsCachedResponses;
 }
 
 /**
@@ -84,9 +86,34 @@
  * In cases where CoreData is used for local object storage/caching, a reference to
  * the managedObjectStore for use in retrieving locally cached objects using the store's
  * managedObjectCache property.
+ *
+ * When the store has a managedObjectCache, collections of managed objects are fingerprinted by
+ * resource path. A payload identical to the last one mapped for the resource path is not parsed,
+ * mapped or saved again; the delegate is sent the objects it was mapped to last time, in payload
+ * order, provided none of them has been deleted since.
  */
 @property (nonatomic, retain) RKManagedObjectStore* managedObjectStore;
 
+/**
+ * When YES, a successful JSON collection payload is parsed chunk by chunk while it downloads,
+ * overlapping parse time with network transfer and avoiding a buffered copy of the body.
+ * Mapping still happens in the background once the load has finished. Object updates
+ * (loaders with a targetObject) and error payloads are always buffered.
+ *
+ * @default NO
+ */
+@property (nonatomic, assign) BOOL parsesIncrementally;
+
+/**
+ * When NO, a collection whose response was answered from the request cache after a 304 Not Modified
+ * is not mapped again. The delegate is instead sent the objects the managed object store's
+ * managedObjectCache returns for the resource path. Loaders without a managed object cache
+ * always map the response.
+ *
+ * @default YES
+ */
+@property (nonatomic, assign) BOOL mapsCachedResponses;
+
 /**
  * Return an auto-released loader with with an object mapper, a request, and a delegate
  */
@@ -7,19 +7,35 @@
 //
 
 #import <CoreData/CoreData.h>
+#import <CommonCrypto/CommonDigest.h>
 #import "../CoreData/RKManagedObjectStore.h"
 #import "RKObjectLoader.h"
+#import "RKObjectMappingQueue.h"
 #import "RKObjectManager.h"
 #import "Errors.h"
+#import "RKDigest.h"
 #import "RKManagedObject.h"
 #import "RKURL.h"
 #import "RKNotifications.h"
 #import <UIKit/UIKit.h>
 
+@interface RKObjectLoader (Private)
+
+- (void)didLoadCoalescedObjects:(NSArray*)objects fromResponse:(RKResponse*)response;
+- (void)didFailCoalescedLoadWithError:(NSError*)error fromResponse:(RKResponse*)response;
+- (BOOL)loadObjectsFromManagedObjectCacheForResponse:(RKResponse*)response;
+- (NSString*)contentFingerprintForResponse:(RKResponse*)response;
+- (void)mapObjectsFromResponse:(RKResponse*)response;
+- (id)parsedBodyOfResponse:(RKResponse*)response;
+- (void)failWithError:(NSError*)error;
+
+@end
+
 @implementation RKObjectLoader
 
 @synthesize mapper = _mapper, response = _response, objectClass = _objectClass, targetObject = _targetObject,
-			keyPath = _keyPath, managedObjectStore = _managedObjectStore;
+			keyPath = _keyPath, managedObjectStore = _managedObjectStore, parsesIncrementally = _parsesIncrementally,
+			mapsCachedResponses = _mapsCachedResponses;
 
 + (id)loaderWithResourcePath:(NSString*)resourcePath mapper:(RKObjectMapper*)mapper delegate:(NSObject<RKObjectLoaderDelegate>*)delegate {
 	return [self loaderWithResourcePath:resourcePath client:[RKClient sharedClient] mapper:mapper delegate:delegate];
@@ -38,6 +54,8 @@
 		_mapper = [mapper retain];
 		self.managedObjectStore = nil;
 		_targetObjectID = nil;
+		_parsesIncrementally = NO;
+		_mapsCachedResponses = YES;
 		_client = [client retain];
 		[_client setupRequest:self];
 	}
@@ -75,6 +93,7 @@
 
 - (void)responseProcessingSuccessful:(BOOL)successful withError:(NSError*)error {
 	_isLoading = NO;
+	[self didCollectMetricsWithResponse:_response error:error];
 
 	NSDate* receivedAt = [NSDate date];
 	if (successful) {
@@ -109,10 +128,10 @@
 		NSError* error = nil;
 
 		if ([response isJSON]) {
-			error = [_mapper parseErrorFromString:[response bodyAsString]];
+			error = [_mapper parseErrorFromData:[response body]];
 			[(NSObject<RKObjectLoaderDelegate>*)_delegate objectLoader:self didFailWithError:error];
 
-		} else if ([response isServiceUnavailable] && [_client serviceUnavailableAlertEnabled]) {
+		} else if ([response isServiceUnavailable] && [_client serviceUnavailableAlertEnabled] && response.request == self) {
 			if ([_delegate respondsToSelector:@selector(objectLoaderDidLoadUnexpectedResponse:)]) {
 				[(NSObject<RKObjectLoaderDelegate>*)_delegate objectLoaderDidLoadUnexpectedResponse:self];
 			}
@@ -158,9 +177,17 @@
 		}
 	}
 
-	[(NSObject<RKObjectLoaderDelegate>*)_delegate objectLoader:self didLoadObjects:[NSArray arrayWithArray:objects]];
+	// Finishing releases this loader from the queue, so the coalesced loaders are collected first
+	NSArray* coalescedLoaders = [self takeCoalescedRequests];
+	RKResponse* response = [[_response retain] autorelease];
+	NSArray* loadedObjects = [NSArray arrayWithArray:objects];
+	[(NSObject<RKObjectLoaderDelegate>*)_delegate objectLoader:self didLoadObjects:loadedObjects];
 
 	[self responseProcessingSuccessful:YES withError:nil];
+
+	for (RKObjectLoader* loader in coalescedLoaders) {
+		[loader didLoadCoalescedObjects:loadedObjects fromResponse:response];
+	}
 }
 
 - (void)informDelegateOfObjectLoadErrorWithInfoDictionary:(NSDictionary*)dictionary {
@@ -174,13 +201,70 @@
 							  nil];
 	NSError *rkError = [NSError errorWithDomain:RKRestKitErrorDomain code:RKObjectLoaderRemoteSystemError userInfo:userInfo];
 
-	[(NSObject<RKObjectLoaderDelegate>*)_delegate objectLoader:self didFailWithError:rkError];
+	[self failWithError:rkError];
+}
+
+// Fails this loader and the loaders waiting on the objects it was going to map
+- (void)failWithError:(NSError*)error {
+	NSArray* coalescedLoaders = [self takeCoalescedRequests];
+	RKResponse* response = [[_response retain] autorelease];
+	[(NSObject<RKObjectLoaderDelegate>*)_delegate objectLoader:self didFailWithError:error];
+
+	[self responseProcessingSuccessful:NO withError:error];
+
+	for (RKObjectLoader* loader in coalescedLoaders) {
+		[loader didFailCoalescedLoadWithError:error fromResponse:response];
+	}
+}
+
+// Finishes a loader that was coalesced into another one with the objects mapped by the other loader
+- (void)didLoadCoalescedObjects:(NSArray*)objects fromResponse:(RKResponse*)response {
+	[_response release];
+	_response = [response retain];
+
+	if ([_delegate respondsToSelector:@selector(request:didLoadResponse:)]) {
+		[_delegate request:self didLoadResponse:response];
+	}
+	[(NSObject<RKObjectLoaderDelegate>*)_delegate objectLoader:self didLoadObjects:objects];
 
-	[self responseProcessingSuccessful:NO withError:rkError];
+	[self responseProcessingSuccessful:YES withError:nil];
+}
+
+// Fails a loader that was coalesced into another one with the error the other loader encountered while mapping
+- (void)didFailCoalescedLoadWithError:(NSError*)error fromResponse:(RKResponse*)response {
+	[_response release];
+	_response = [response retain];
+
+	if ([_delegate respondsToSelector:@selector(request:didLoadResponse:)]) {
+		[_delegate request:self didLoadResponse:response];
+	}
+	[(NSObject<RKObjectLoaderDelegate>*)_delegate objectLoader:self didFailWithError:error];
+
+	[self responseProcessingSuccessful:NO withError:error];
 }
 
 - (void)processLoadModelsInBackground:(RKResponse *)response {
 	NSAutoreleasePool* pool = [[NSAutoreleasePool alloc] init];
+	@try {
+		[self mapObjectsFromResponse:response];
+	}
+	@catch (NSException* e) {
+		NSLog(@"[RestKit] RKObjectLoader: Exception (%@) raised while mapping response: %@", [e name], [e reason]);
+		NSString* description = [NSString stringWithFormat:@"%@: %@", [e name], [e reason]];
+		NSDictionary* userInfo = [NSDictionary dictionaryWithObject:description forKey:NSLocalizedDescriptionKey];
+		NSError* error = [NSError errorWithDomain:RKRestKitErrorDomain code:RKObjectLoaderMappingError userInfo:userInfo];
+
+		// The mapping thread outlives this load. Its context is kept warm for the next load, but
+		// the unsaved objects of a failed mapping must not leak into it
+		[self.managedObjectStore resetManagedObjectContext];
+		[self performSelectorOnMainThread:@selector(failWithError:) withObject:error waitUntilDone:YES];
+	}
+	@finally {
+		[pool drain];
+	}
+}
+
+- (void)mapObjectsFromResponse:(RKResponse*)response {
 	RKManagedObjectStore* objectStore = self.managedObjectStore;
 
 	/**
@@ -189,21 +273,39 @@
 	 * individual object instances via getObject & friends.
 	 */
 	NSArray* results = nil;
+	NSString* fingerprint = [self contentFingerprintForResponse:response];
+	NSArray* unchangedObjectIDs = (fingerprint ? [objectStore objectIDsForContentFingerprint:fingerprint resourcePath:self.resourcePath] : nil);
+	BOOL isUnchanged = NO;
+	RKRequestMetrics* metrics = self.metrics;
+	NSTimeInterval parseDuration = metrics.parseDuration;
+	NSTimeInterval mappingStartTime = [NSDate timeIntervalSinceReferenceDate];
 	if (self.targetObject) {
 		if (_targetObjectID) {
 			NSManagedObject* backgroundThreadModel = [self.managedObjectStore objectWithID:_targetObjectID];
 			if (self.method == RKRequestMethodDELETE) {
 				[[objectStore managedObjectContext] deleteObject:backgroundThreadModel];
 			} else {
-				[_mapper mapObject:backgroundThreadModel fromString:[response bodyAsString]];
+				[_mapper mapObject:backgroundThreadModel fromParsedObject:[self parsedBodyOfResponse:response]];
 				results = [NSArray arrayWithObject:backgroundThreadModel];
 			}
 		} else {
-			[_mapper mapObject:self.targetObject fromString:[response bodyAsString]];
+			[_mapper mapObject:self.targetObject fromParsedObject:[self parsedBodyOfResponse:response]];
 			results = [NSArray arrayWithObject:self.targetObject];
 		}
+	} else if (unchangedObjectIDs) {
+		// The payload is the one last mapped into the store and its objects still exist. Their IDs
+		// are handed over as they are, in payload order, just like the IDs of freshly mapped objects
+		results = unchangedObjectIDs;
+		isUnchanged = YES;
 	} else {
-		id result = [_mapper mapFromString:[response bodyAsString] toClass:self.objectClass keyPath:_keyPath];
+		id result = nil;
+		if ([response wasParsedIncrementally]) {
+			result = [_mapper mapParsedObject:[response parsedBody] toClass:self.objectClass keyPath:_keyPath];
+		} else if (_mapper.streamingEnabled) {
+			result = [_mapper mapFromData:[response body] toClass:self.objectClass keyPath:_keyPath];
+		} else {
+			result = [_mapper mapParsedObject:[self parsedBodyOfResponse:response] toClass:self.objectClass keyPath:_keyPath];
+		}
 		if ([result isKindOfClass:[NSArray class]]) {
 			results = (NSArray*)result;
 		} else {
@@ -228,10 +330,18 @@
 		}
 	}
 
+	NSTimeInterval saveStartTime = [NSDate timeIntervalSinceReferenceDate];
+	metrics.mappingDuration = saveStartTime - mappingStartTime - (metrics.parseDuration - parseDuration);
+
 	// Before looking up NSManagedObjectIDs, need to save to ensure we do not have
 	// temporary IDs for new objects prior to handing the objectIDs across threads
-	NSError* error = [objectStore save];
+	NSError* error = isUnchanged ? nil : [objectStore save];
+	NSTimeInterval mergeDuration = isUnchanged ? 0 : [objectStore mergeDurationOfLastSave];
+	metrics.saveDuration = [NSDate timeIntervalSinceReferenceDate] - saveStartTime - mergeDuration;
+	metrics.mergeDuration = mergeDuration;
 	if (nil != error) {
+		[objectStore resetManagedObjectContext];
+		[objectStore setContentFingerprint:nil objectIDs:nil forResourcePath:self.resourcePath];
 		NSDictionary* infoDictionary = [[NSDictionary dictionaryWithObjectsAndKeys:response, @"response", error, @"error", nil] retain];
 		[self performSelectorOnMainThread:@selector(informDelegateOfObjectLoadErrorWithInfoDictionary:) withObject:infoDictionary waitUntilDone:YES];
 	} else {
@@ -247,14 +357,85 @@
 			}
 		}
 
+		if (fingerprint && NO == isUnchanged) {
+			[objectStore setContentFingerprint:fingerprint objectIDs:models forResourcePath:self.resourcePath];
+		}
+
 		NSDictionary* infoDictionary = [[NSDictionary dictionaryWithObjectsAndKeys:response, @"response", models, @"models", nil] retain];
 		[self performSelectorOnMainThread:@selector(informDelegateOfObjectLoadWithInfoDictionary:) withObject:infoDictionary waitUntilDone:YES];
 	}
+}
+
+// Parses the body of a buffered response, accounting the time spent in the metrics of the loader
+- (id)parsedBodyOfResponse:(RKResponse*)response {
+	NSTimeInterval parseStartTime = [NSDate timeIntervalSinceReferenceDate];
+	id parsedBody = [_mapper parseData:[response body]];
+	self.metrics.parseDuration += [NSDate timeIntervalSinceReferenceDate] - parseStartTime;
+
+	return parsedBody;
+}
+
+// Sends the delegate the objects already stored for the resource path without mapping the response
+- (BOOL)loadObjectsFromManagedObjectCacheForResponse:(RKResponse*)response {
+	NSObject<RKManagedObjectCache>* managedObjectCache = [self.managedObjectStore managedObjectCache];
+	if (self.targetObject || nil == managedObjectCache || nil == self.resourcePath) {
+		return NO;
+	}
+
+	NSArray* fetchRequests = [managedObjectCache fetchRequestsForResourcePath:self.resourcePath];
+	NSArray* objects = [RKManagedObject objectsWithFetchRequests:fetchRequests];
+	NSDictionary* infoDictionary = [[NSDictionary dictionaryWithObjectsAndKeys:response, @"response", objects, @"models", nil] retain];
+	[self informDelegateOfObjectLoadWithInfoDictionary:infoDictionary];
+	return YES;
+}
+
+// Identifies the payload a collection of managed objects was mapped from, so an identical payload need not
+// be mapped again. The object class and key path are part of the fingerprint as they decide what the payload maps to
+- (NSString*)contentFingerprintForResponse:(RKResponse*)response {
+	Class objectClass = self.objectClass;
+	if (self.targetObject || NO == [objectClass isSubclassOfClass:[NSManagedObject class]] || nil == [self.managedObjectStore managedObjectCache] ||
+		nil == self.resourcePath || [response wasParsedIncrementally]) {
+		return nil;
+	}
+
+	NSData* body = [response body];
+	NSData* context = [[NSString stringWithFormat:@"%@\n%@\n", NSStringFromClass(self.objectClass), _keyPath] dataUsingEncoding:NSUTF8StringEncoding];
+	unsigned char digest[CC_SHA1_DIGEST_LENGTH];
+	CC_SHA1_CTX ctx;
+	CC_SHA1_Init(&ctx);
+	CC_SHA1_Update(&ctx, [context bytes], (CC_LONG)[context length]);
+	CC_SHA1_Update(&ctx, [body bytes], (CC_LONG)[body length]);
+	CC_SHA1_Final(digest, &ctx);
 
-	[pool drain];
+	return RKHexStringFromBytes(digest, CC_SHA1_DIGEST_LENGTH);
+}
+
+- (NSObject<RKStreamingParser>*)streamingParserForResponse:(RKResponse*)response {
+	if (_parsesIncrementally && nil == self.targetObject && [response isSuccessful] && [response isJSON]) {
+		return [_mapper incrementalParser];
+	}
+	
+	return nil;
+}
+
+- (NSString*)coalescingKey {
+	// Loaders only share a response when they would map it into the same objects
+	NSString* key = [super coalescingKey];
+	if (nil == key || self.targetObject) {
+		return nil;
+	}
+
+	return [NSString stringWithFormat:@"%@\n%p %p %@ %@ %d %d", key, _mapper, _managedObjectStore, NSStringFromClass(_objectClass), _keyPath,
+			_parsesIncrementally, _mapsCachedResponses];
 }
 
 - (void)didFailLoadWithError:(NSError*)error {
+	[self retain];
+	for (RKObjectLoader* loader in [self takeCoalescedRequests]) {
+		[loader didFailLoadWithError:error];
+	}
+	[self autorelease];
+
 	if ([_delegate respondsToSelector:@selector(request:didFailLoadWithError:)]) {
 		[_delegate request:self didFailLoadWithError:error];
 	}
@@ -271,10 +452,29 @@
 		[_delegate request:self didLoadResponse:response];
 	}
 
+	// Coalesced loaders wait for the objects mapped by this loader. When nothing is going to be
+	// mapped they reach the same outcome by processing the response themselves
+	BOOL willMapResponse = (NO == [response isFailure] && NO == [response isError] && [response isSuccessful] && [response isJSON]);
+	if (NO == willMapResponse) {
+		[self retain];
+		for (RKObjectLoader* loader in [self takeCoalescedRequests]) {
+			[loader didFinishLoad:response];
+		}
+		[self autorelease];
+	}
+
 	if (NO == [self encounteredErrorWhileProcessingRequest:response]) {
 		// TODO: When other mapping formats are supported, unwind this assumption... Should probably be an expected MIME types array set by client/manager
 		if ([response isSuccessful] && [response isJSON]) {
-			[self performSelectorInBackground:@selector(processLoadModelsInBackground:) withObject:response];
+			if ([response parseError]) {
+				NSLog(@"[RestKit] RKObjectLoader: Error (%@) incrementally parsing response body", [[response parseError] localizedDescription]);
+				[self failWithError:[response parseError]];
+				return;
+			}
+			if (NO == _mapsCachedResponses && [response wasLoadedFromCache] && [self loadObjectsFromManagedObjectCacheForResponse:response]) {
+				return;
+			}
+			[[RKObjectMappingQueue sharedQueue] addOperationWithTarget:self selector:@selector(processLoadModelsInBackground:) object:response];
 		} else {
 			NSLog(@"Encountered unexpected response code: %d (MIME Type: %@)", response.statusCode, response.MIMEType);
 			if ([_delegate respondsToSelector:@selector(objectLoaderDidLoadUnexpectedResponse:)]) {
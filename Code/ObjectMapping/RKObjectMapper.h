@@ -40,11 +40,16 @@ typedef enum {
 	RKMappingFormat _format;
 	RKMissingElementMappingPolicy _missingElementMappingPolicy;
 	RKObjectPropertyInspector* _inspector;
+	NSMutableDictionary* _mappingPlans;
 	NSArray* _dateFormats;
 	NSTimeZone* _remoteTimeZone;
 	NSTimeZone* _localTimeZone;
 	NSString* _errorsKeyPath;
 	NSString* _errorsConcatenationString;
+	BOOL _streamingEnabled;
+	BOOL _parallelMappingEnabled;
+	NSUInteger _parallelMappingThreshold;
+	NSOperationQueue* _parallelMappingQueue;
 }
 
 /**
@@ -94,9 +99,44 @@ typedef enum {
  */
 @property (nonatomic, copy) NSString* errorsConcatenationString;
 
+/**
+ * When YES, collections mapped via mapFromData:toClass:keyPath: are mapped element by element
+ * as the parser encounters them rather than after the entire payload has been parsed. Peak
+ * memory use then scales with a single object instead of the whole document. Only takes effect
+ * when the parser supports streaming.
+ *
+ * @default NO
+ */
+@property (nonatomic, assign) BOOL streamingEnabled;
+
+/**
+ * When YES, collections of at least parallelMappingThreshold elements are split into one chunk
+ * per active processor and the chunks are mapped concurrently. The mapped objects are returned in
+ * the order of the collection.
+ *
+ * Managed objects are always mapped serially, in the managed object context of the calling thread:
+ * objects related to several elements must be found or created by a single context. Collections are
+ * therefore only mapped in parallel when neither their elements nor the objects reachable through
+ * the relationship mappings of the element classes are managed objects. Collections of plain
+ * objects are mapped in parallel even when managed object classes are registered with the mapper.
+ *
+ * @default NO
+ */
+@property (nonatomic, assign) BOOL parallelMappingEnabled;
+
+/**
+ * The minimum number of elements in a collection for it to be mapped in parallel
+ *
+ * @default 1000
+ */
+@property (nonatomic, assign) NSUInteger parallelMappingThreshold;
+
 /**
  * Register a mapping for a given class for an XML element with the given tag name
  * will blow up if the class does not respond to elementToPropertyMappings and elementToRelationshipMappings
+ *
+ * The mapping plan for the class is compiled at registration time and reused for
+ * every object of the class mapped afterwards
  */
 - (void)registerClass:(Class<RKObjectMappable>)aClass forElementNamed:(NSString*)elementName;
 
@@ -115,12 +155,30 @@ typedef enum {
  */
 - (NSError*)parseErrorFromString:(NSString*)string;
 
+/**
+ * Digests a raw payload (such as an error response body) in to an NSError.
+ * It should only be called for a payload you know contains an error.
+ */
+- (NSError*)parseErrorFromData:(NSData*)data;
+
 /**
  * Sets the properties and relationships serialized in the string into the model instance
  * provided
  */
 - (void)mapObject:(id)model fromString:(NSString*)string;
 
+/**
+ * Sets the properties and relationships serialized in the raw payload into the model instance
+ * provided
+ */
+- (void)mapObject:(id)model fromData:(NSData*)data;
+
+/**
+ * Sets the properties and relationships of an already parsed payload into the model instance
+ * provided
+ */
+- (void)mapObject:(id)model fromParsedObject:(id)object;
+
 ///////////////////////////////////////////////////////////////////////////////
 // Object Mapping API
 
@@ -151,6 +209,19 @@ typedef enum {
  */
 - (id)mapFromString:(NSString *)string toClass:(Class)class keyPath:(NSString*)keyPath;
 
+/**
+ * Map the objects in a raw payload to a particular object class, optionally filtering
+ * the parsed result set via a keyPath before mapping the results. Streams the collection
+ * at keyPath through the mapper when streamingEnabled is YES.
+ */
+- (id)mapFromData:(NSData*)data toClass:(Class)class keyPath:(NSString*)keyPath;
+
+/**
+ * Map an already parsed payload to a particular object class, optionally filtering
+ * the parsed result set via a keyPath before mapping the results.
+ */
+- (id)mapParsedObject:(id)object toClass:(Class)class keyPath:(NSString*)keyPath;
+
 /**
  * Map an array of object dictionary representations to instances of a particular
  * object class
@@ -162,4 +233,15 @@ typedef enum {
  */
 - (id)parseString:(NSString*)string;
 
+/**
+ * Parse a raw UTF-8 payload using the appropriate parser and return the results
+ */
+- (id)parseData:(NSData*)data;
+
+/**
+ * Returns a new parser for assembling a payload from chunks as they arrive, or nil when
+ * the parser for the mapping format cannot parse incrementally
+ */
+- (NSObject<RKStreamingParser>*)incrementalParser;
+
 @end
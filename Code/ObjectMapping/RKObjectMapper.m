@@ -12,7 +12,9 @@
 #import "../CoreData/CoreData.h"
 
 #import "RKObjectMapper.h"
+#import "RKObjectMappingPlan.h"
 #import "NSDictionary+RKAdditions.h"
+#import "RKDateParser.h"
 #import "RKJSONParser.h"
 #import "Errors.h"
 
@@ -22,28 +24,180 @@ static const NSString* kRKModelMapperRailsDateTimeFormatString = @"yyyy-MM-dd'T'
 static const NSString* kRKModelMapperRailsDateFormatString = @"MM/dd/yyyy";
 static const NSString* kRKModelMapperNetDateTimeFormatString = @"'Date('ssssssssss'-'ssss')'"; 
 static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatParser";
+static const NSString* kRKModelMapperDateFormattersKey = @"RKModelMapperDateFormatters";
+
+// Streamed elements are mapped in batches so their primary keys can be fetched together
+static const NSUInteger kRKObjectMapperStreamingBatchSize = 500;
+
+@class RKObjectMapperChunk;
 
 @interface RKObjectMapper (Private)
 
+- (NSObject<RKParser>*)parser;
 - (id)parseString:(NSString*)string;
+- (id)parseData:(NSData*)data;
+- (NSError*)errorFromParsedObject:(id)object;
+- (id)mapElement:(id)element toClass:(Class)class;
+- (Class)classOfElement:(id)element mappedToClass:(Class)class elements:(id*)elements;
+- (BOOL)shouldMapInParallelArrayOfElements:(NSArray*)array toClass:(Class)class;
+- (NSArray*)mapObjectsInParallelFromArrayOfDictionaries:(NSArray*)array toClass:(Class)class;
+- (void)mapChunk:(RKObjectMapperChunk*)chunk;
 - (void)updateModel:(id)model fromElements:(NSDictionary*)elements;
 
 - (Class)typeClassForProperty:(NSString*)property ofClass:(Class)class;
 - (NSDictionary*)elementToPropertyMappingsForModel:(id)model;
 
 - (id)findOrCreateInstanceOfModelClass:(Class)class fromElements:(NSDictionary*)elements;
+- (void)findInstancesOfModelClass:(Class)class fromArrayOfElements:(id)array;
 - (id)createOrUpdateInstanceOfModelClass:(Class)class fromElements:(NSDictionary*)elements;
 
+- (RKObjectMappingPlan*)mappingPlanForClass:(Class)class;
 - (void)updateModel:(id)model ifNewPropertyValue:(id)propertyValue forPropertyNamed:(NSString*)propertyName; // Rename!
+- (void)updateModel:(id)model ifNewPropertyValue:(id)propertyValue forPropertyMapping:(RKObjectPropertyMapping*)propertyMapping;
 - (void)setPropertiesOfModel:(id)model fromElements:(NSDictionary*)elements;
 - (void)setRelationshipsOfModel:(id)object fromElements:(NSDictionary*)elements;
 - (void)updateModel:(id)model fromElements:(NSDictionary*)elements;
 
 - (NSDate*)parseDateFromString:(NSString*)string;
+- (NSDate*)parseDateFromString:(NSString*)string forPropertyMapping:(RKObjectPropertyMapping*)propertyMapping;
+- (NSDate*)parseDateFromString:(NSString*)string withFormat:(NSString*)formatString;
+- (NSDateFormatter*)dateFormatterForFormat:(NSString*)formatString;
 - (NSDate*)dateInLocalTime:(NSDate*)date;
 
 @end
 
+/**
+ * Receives the elements of a streamed collection and maps them in batches as they arrive
+ */
+@interface RKObjectMapperStreamingTarget : NSObject <RKStreamingParserDelegate> {
+	RKObjectMapper* _mapper;
+	Class _objectClass;
+	NSMutableArray* _objects;
+	NSMutableArray* _pendingElements;
+}
+
+@property (nonatomic, readonly) NSArray* objects;
+
+- (id)initWithMapper:(RKObjectMapper*)mapper objectClass:(Class)objectClass;
+
+/**
+ * Maps the elements received since the last batch was mapped. Invoked once parsing has finished
+ */
+- (void)mapPendingElements;
+
+@end
+
+@implementation RKObjectMapperStreamingTarget
+
+@synthesize objects = _objects;
+
+- (id)initWithMapper:(RKObjectMapper*)mapper objectClass:(Class)objectClass {
+	if ((self = [self init])) {
+		_mapper = [mapper retain];
+		_objectClass = objectClass;
+		_objects = [[NSMutableArray alloc] init];
+		_pendingElements = [[NSMutableArray alloc] initWithCapacity:kRKObjectMapperStreamingBatchSize];
+	}
+
+	return self;
+}
+
+- (void)dealloc {
+	[_mapper release];
+	[_objects release];
+	[_pendingElements release];
+	[super dealloc];
+}
+
+- (void)parser:(NSObject<RKStreamingParser>*)parser didParseObject:(id)object {
+	[_pendingElements addObject:object];
+	if ([_pendingElements count] >= kRKObjectMapperStreamingBatchSize) {
+		[self mapPendingElements];
+	}
+}
+
+// Drains the intermediates of each batch so memory use stays flat across the collection. An
+// exception is kept alive past the drain so it can propagate to the caller
+- (void)mapPendingElements {
+	NSAutoreleasePool* pool = [[NSAutoreleasePool alloc] init];
+	NSException* exception = nil;
+	@try {
+		[_mapper findInstancesOfModelClass:_objectClass fromArrayOfElements:_pendingElements];
+		for (id element in _pendingElements) {
+			id mappedObject = [_mapper mapElement:element toClass:_objectClass];
+			if (mappedObject) {
+				[_objects addObject:mappedObject];
+			}
+		}
+	}
+	@catch (NSException* e) {
+		exception = [e retain];
+		@throw;
+	}
+	@finally {
+		[_pendingElements removeAllObjects];
+		[pool drain];
+		[exception autorelease];
+	}
+}
+
+@end
+
+/**
+ * The contiguous range of a collection mapped by one operation during parallel mapping
+ */
+@interface RKObjectMapperChunk : NSObject {
+	Class _objectClass;
+	NSMutableArray* _elements;
+	NSMutableArray* _results;
+	NSConditionLock* _completionLock;
+	NSException* _exception;
+}
+
+@property (nonatomic, readonly) Class objectClass;
+@property (nonatomic, readonly) NSArray* elements;
+@property (nonatomic, readonly) NSMutableArray* results;
+@property (nonatomic, readonly) NSConditionLock* completionLock;
+@property (nonatomic, retain) NSException* exception;
+
+- (id)initWithObjectClass:(Class)objectClass completionLock:(NSConditionLock*)completionLock;
+- (void)addElement:(id)element;
+
+@end
+
+@implementation RKObjectMapperChunk
+
+@synthesize objectClass = _objectClass;
+@synthesize elements = _elements;
+@synthesize results = _results;
+@synthesize completionLock = _completionLock;
+@synthesize exception = _exception;
+
+- (id)initWithObjectClass:(Class)objectClass completionLock:(NSConditionLock*)completionLock {
+	if ((self = [self init])) {
+		_objectClass = objectClass;
+		_elements = [[NSMutableArray alloc] init];
+		_results = [[NSMutableArray alloc] init];
+		_completionLock = [completionLock retain];
+	}
+	
+	return self;
+}
+
+- (void)dealloc {
+	[_elements release];
+	[_results release];
+	[_completionLock release];
+	[_exception release];
+	[super dealloc];
+}
+
+- (void)addElement:(id)element {
+	[_elements addObject:element];
+}
+
+@end
+
 @implementation RKObjectMapper
 
 @synthesize format = _format;
@@ -53,6 +207,9 @@ static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatP
 @synthesize localTimeZone = _localTimeZone;
 @synthesize errorsKeyPath = _errorsKeyPath;
 @synthesize errorsConcatenationString = _errorsConcatenationString;
+@synthesize streamingEnabled = _streamingEnabled;
+@synthesize parallelMappingEnabled = _parallelMappingEnabled;
+@synthesize parallelMappingThreshold = _parallelMappingThreshold;
 
 ///////////////////////////////////////////////////////////////////////////////
 // public
@@ -62,12 +219,18 @@ static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatP
 		_elementToClassMappings = [[NSMutableDictionary alloc] init];
 		_format = RKMappingFormatJSON;
 		_missingElementMappingPolicy = RKIgnoreMissingElementMappingPolicy;
-		_inspector = [[RKObjectPropertyInspector alloc] init];
+		_inspector = [[RKObjectPropertyInspector sharedInspector] retain];
+		_mappingPlans = [[NSMutableDictionary alloc] init];
 		self.dateFormats = [NSArray arrayWithObjects:kRKModelMapperRailsDateTimeFormatString, kRKModelMapperRailsDateFormatString, kRKModelMapperNetDateTimeFormatString, nil];
 		self.remoteTimeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
 		self.localTimeZone = [NSTimeZone localTimeZone];
 		self.errorsKeyPath = @"errors";
 		self.errorsConcatenationString = @", ";
+		_streamingEnabled = NO;
+		_parallelMappingEnabled = NO;
+		_parallelMappingThreshold = 1000;
+		_parallelMappingQueue = [[NSOperationQueue alloc] init];
+		[_parallelMappingQueue setMaxConcurrentOperationCount:[[NSProcessInfo processInfo] activeProcessorCount]];
 	}
 	return self;
 }
@@ -75,6 +238,8 @@ static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatP
 - (void)dealloc {
 	[_elementToClassMappings release];
 	[_inspector release];
+	[_mappingPlans release];
+	[_parallelMappingQueue release];
 	[_dateFormats release];
 	[_errorsKeyPath release];
 	[_errorsConcatenationString release];
@@ -83,6 +248,7 @@ static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatP
 
 - (void)registerClass:(Class<RKObjectMappable>)aClass forElementNamed:(NSString*)elementName {
 	[_elementToClassMappings setObject:aClass forKey:elementName];
+	[self mappingPlanForClass:aClass];
 }
 
 - (void)setFormat:(RKMappingFormat)format {
@@ -95,7 +261,7 @@ static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatP
 ///////////////////////////////////////////////////////////////////////////////
 // Mapping from a string
 
-- (id)parseString:(NSString*)string {
+- (NSObject<RKParser>*)parser {
 	NSMutableDictionary* threadDictionary = [[NSThread currentThread] threadDictionary];
 	NSObject<RKParser>* parser = [threadDictionary objectForKey:kRKModelMapperMappingFormatParserKey];
 	if (!parser) {
@@ -106,9 +272,22 @@ static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatP
 		}
 	}
 	
+	return parser;
+}
+
+- (NSObject<RKStreamingParser>*)incrementalParser {
+	NSObject<RKParser>* parser = [self parser];
+	if ([parser respondsToSelector:@selector(streamingParserWithKeyPath:delegate:)]) {
+		return [parser streamingParserWithKeyPath:nil delegate:nil];
+	}
+	
+	return nil;
+}
+
+- (id)parseString:(NSString*)string {
 	id result = nil;
 	@try {
-		result = [parser objectFromString:string];
+		result = [[self parser] objectFromString:string];
 	}
 	@catch (NSException* e) {
 		NSLog(@"[RestKit] RKObjectMapper:parseString: Exception (%@) parsing error from string: %@", [e reason], string);
@@ -116,8 +295,34 @@ static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatP
 	return result;
 }
 
+- (id)parseData:(NSData*)data {
+	id result = nil;
+	@try {
+		NSObject<RKParser>* parser = [self parser];
+		if ([parser respondsToSelector:@selector(objectFromData:)]) {
+			result = [parser objectFromData:data];
+		} else {
+			NSString* string = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+			result = [parser objectFromString:string];
+			[string release];
+		}
+	}
+	@catch (NSException* e) {
+		NSLog(@"[RestKit] RKObjectMapper:parseData: Exception (%@) parsing error from data of length %u", [e reason], (unsigned int)[data length]);
+	}
+	return result;
+}
+
 - (NSError*)parseErrorFromString:(NSString*)string {
-	NSString* errorMessage = [[[self parseString:string] valueForKeyPath:_errorsKeyPath] componentsJoinedByString:_errorsConcatenationString];
+	return [self errorFromParsedObject:[self parseString:string]];
+}
+
+- (NSError*)parseErrorFromData:(NSData*)data {
+	return [self errorFromParsedObject:[self parseData:data]];
+}
+
+- (NSError*)errorFromParsedObject:(id)object {
+	NSString* errorMessage = [[object valueForKeyPath:_errorsKeyPath] componentsJoinedByString:_errorsConcatenationString];
 	NSDictionary *userInfo = [NSDictionary dictionaryWithObjectsAndKeys:
 							  errorMessage, NSLocalizedDescriptionKey,
 							  nil];
@@ -128,6 +333,32 @@ static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatP
 
 - (id)mapFromString:(NSString*)string toClass:(Class)class keyPath:(NSString*)keyPath {
 	id object = [self parseString:string];
+	return [self mapParsedObject:object toClass:class keyPath:keyPath];
+}
+
+- (id)mapFromData:(NSData*)data toClass:(Class)class keyPath:(NSString*)keyPath {
+	NSObject<RKParser>* parser = [self parser];
+	if (NO == _streamingEnabled || NO == [parser respondsToSelector:@selector(streamingParserWithKeyPath:delegate:)]) {
+		return [self mapParsedObject:[self parseData:data] toClass:class keyPath:keyPath];
+	}
+	
+	RKObjectMapperStreamingTarget* target = [[[RKObjectMapperStreamingTarget alloc] initWithMapper:self objectClass:class] autorelease];
+	NSObject<RKStreamingParser>* streamingParser = [parser streamingParserWithKeyPath:keyPath delegate:target];
+	if (NO == [streamingParser parseData:data] || NO == [streamingParser finishParsing]) {
+		NSLog(@"[RestKit] RKObjectMapper:mapFromData: Error (%@) parsing streamed payload", [streamingParser.error localizedDescription]);
+		return nil;
+	}
+	
+	if ([streamingParser isStreaming]) {
+		[target mapPendingElements];
+		return target.objects;
+	}
+	
+	// The payload did not contain a collection at keyPath. Map it as a whole
+	return [self mapParsedObject:streamingParser.result toClass:class keyPath:keyPath];
+}
+
+- (id)mapParsedObject:(id)object toClass:(Class)class keyPath:(NSString*)keyPath {
 	if (keyPath) {
 		object = [object valueForKeyPath:keyPath];
 	}
@@ -154,7 +385,14 @@ static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatP
 }
 
 - (void)mapObject:(id)model fromString:(NSString*)string {
-	id object = [self parseString:string];
+	[self mapObject:model fromParsedObject:[self parseString:string]];
+}
+
+- (void)mapObject:(id)model fromData:(NSData*)data {
+	[self mapObject:model fromParsedObject:[self parseData:data]];
+}
+
+- (void)mapObject:(id)model fromParsedObject:(id)object {
 	if ([object isKindOfClass:[NSDictionary class]]) {
 		[self mapObject:model fromDictionary:object];
 	} else if (nil == object) {
@@ -206,15 +444,20 @@ static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatP
 }
 
 - (NSArray*)mapObjectsFromArrayOfDictionaries:(NSArray*)array {
+	return [self mapObjectsFromArrayOfDictionaries:array toClass:nil];
+}
+
+- (NSArray*)mapObjectsFromArrayOfDictionaries:(NSArray*)array toClass:(Class)class {
+	if ([self shouldMapInParallelArrayOfElements:array toClass:class]) {
+		return [self mapObjectsInParallelFromArrayOfDictionaries:array toClass:class];
+	}
+	
+	[self findInstancesOfModelClass:class fromArrayOfElements:array];
+	
 	NSMutableArray* objects = [NSMutableArray array];
 	for (NSDictionary* dictionary in array) {
-		if (![dictionary isKindOfClass:[NSNull class]]) {
-			// TODO: Makes assumptions about the structure of the JSON...
-			NSString* elementName = [[dictionary allKeys] objectAtIndex:0];
-			Class class = [_elementToClassMappings objectForKey:elementName];
-			NSAssert(class != nil, @"Unable to perform object mapping without a destination class");
-			NSDictionary* elements = [dictionary objectForKey:elementName];
-			id object = [self createOrUpdateInstanceOfModelClass:class fromElements:elements];
+		id object = [self mapElement:dictionary toClass:class];
+		if (object) {
 			[objects addObject:object];
 		}
 	}
@@ -222,18 +465,148 @@ static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatP
 	return (NSArray*)objects;
 }
 
-- (NSArray*)mapObjectsFromArrayOfDictionaries:(NSArray*)array toClass:(Class)class {
-	NSMutableArray* objects = [NSMutableArray array];
-	for (NSDictionary* dictionary in array) {
-		if (![dictionary isKindOfClass:[NSNull class]]) {
-			id object = [self createOrUpdateInstanceOfModelClass:class fromElements:dictionary];
-			[objects addObject:object];
+// Maps a single element of a collection. When no class is given, the element is expected
+// to be namespaced by a registered element name
+- (id)mapElement:(id)element toClass:(Class)class {
+	if ([element isKindOfClass:[NSNull class]]) {
+		return nil;
+	}
+	
+	NSDictionary* elements = (NSDictionary*)element;
+	if (nil == class) {
+		// TODO: Makes assumptions about the structure of the JSON...
+		NSString* elementName = [[element allKeys] objectAtIndex:0];
+		class = [_elementToClassMappings objectForKey:elementName];
+		NSAssert(class != nil, @"Unable to perform object mapping without a destination class");
+		elements = [element objectForKey:elementName];
+	}
+	
+	return [self createOrUpdateInstanceOfModelClass:class fromElements:elements];
+}
+
+// Returns the class an element of a collection maps to along with the elements to map it from,
+// which are nested under a registered element name when no class is given
+- (Class)classOfElement:(id)element mappedToClass:(Class)class elements:(id*)elements {
+	*elements = element;
+	if (nil == class && [element isKindOfClass:[NSDictionary class]] && [element count] > 0) {
+		NSString* elementName = [[element allKeys] objectAtIndex:0];
+		class = [_elementToClassMappings objectForKey:elementName];
+		*elements = [element objectForKey:elementName];
+	}
+	
+	return class;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Parallel Mapping
+
+- (BOOL)shouldMapInParallelArrayOfElements:(NSArray*)array toClass:(Class)class {
+	if (NO == _parallelMappingEnabled || [array count] < _parallelMappingThreshold || [[NSProcessInfo processInfo] activeProcessorCount] < 2) {
+		return NO;
+	}
+	
+	// Managed objects are confined to the context of the thread mapping them and related objects are
+	// found or created by primary key in that context, so chunks mapped by different threads would each
+	// create their own copy of a shared related object. Only the classes the elements can map to count:
+	// the class of the collection, or of each element name, and the classes of their relationships
+	NSMutableArray* classesToVisit = [NSMutableArray array];
+	if (class) {
+		[classesToVisit addObject:class];
+	} else {
+		for (id element in array) {
+			id elements = nil;
+			Class elementClass = [self classOfElement:element mappedToClass:nil elements:&elements];
+			if (elementClass && NO == [classesToVisit containsObject:elementClass]) {
+				[classesToVisit addObject:elementClass];
+			}
+		}
+	}
+	
+	NSMutableSet* visitedClasses = [NSMutableSet set];
+	while ([classesToVisit count] > 0) {
+		Class visitedClass = [classesToVisit lastObject];
+		[classesToVisit removeLastObject];
+		if ([visitedClasses containsObject:visitedClass]) {
+			continue;
+		}
+		if ([visitedClass isSubclassOfClass:[NSManagedObject class]]) {
+			return NO;
+		}
+		
+		[visitedClasses addObject:visitedClass];
+		for (RKObjectPropertyMapping* relationshipMapping in [self mappingPlanForClass:visitedClass].relationshipMappings) {
+			Class relatedClass = [_elementToClassMappings objectForKey:relationshipMapping.elementName];
+			if (relatedClass) {
+				[classesToVisit addObject:relatedClass];
+			}
+		}
+	}
+	
+	return YES;
+}
+
+- (NSArray*)mapObjectsInParallelFromArrayOfDictionaries:(NSArray*)array toClass:(Class)class {
+	NSUInteger count = [array count];
+	NSUInteger chunkCount = [[NSProcessInfo processInfo] activeProcessorCount];
+	NSConditionLock* completionLock = [[NSConditionLock alloc] initWithCondition:0];
+	NSMutableArray* chunks = [NSMutableArray arrayWithCapacity:chunkCount];
+	NSUInteger i;
+	for (i = 0; i < chunkCount; i++) {
+		RKObjectMapperChunk* chunk = [[RKObjectMapperChunk alloc] initWithObjectClass:class completionLock:completionLock];
+		[chunks addObject:chunk];
+		[chunk release];
+	}
+	
+	for (i = 0; i < count; i++) {
+		[[chunks objectAtIndex:i * chunkCount / count] addElement:[array objectAtIndex:i]];
+	}
+	
+	for (RKObjectMapperChunk* chunk in chunks) {
+		NSInvocationOperation* operation = [[NSInvocationOperation alloc] initWithTarget:self selector:@selector(mapChunk:) object:chunk];
+		[_parallelMappingQueue addOperation:operation];
+		[operation release];
+	}
+	[completionLock lockWhenCondition:chunkCount];
+	[completionLock unlock];
+	[completionLock release];
+	
+	// Chunks hold contiguous ranges of the collection, so concatenating them preserves its order
+	NSMutableArray* objects = [NSMutableArray arrayWithCapacity:count];
+	for (RKObjectMapperChunk* chunk in chunks) {
+		if (chunk.exception) {
+			[chunk.exception raise];
+		}
+		
+		for (id object in chunk.results) {
+			if (object != [NSNull null]) {
+				[objects addObject:object];
+			}
 		}
 	}
 	
 	return (NSArray*)objects;
 }
 
+// Runs on an operation queue thread
+- (void)mapChunk:(RKObjectMapperChunk*)chunk {
+	NSAutoreleasePool* pool = [[NSAutoreleasePool alloc] init];
+	@try {
+		for (id element in chunk.elements) {
+			id object = [self mapElement:element toClass:chunk.objectClass];
+			[chunk.results addObject:(object ? object : [NSNull null])];
+		}
+	}
+	@catch (NSException* exception) {
+		// Raised again on the calling thread once every chunk has finished
+		chunk.exception = exception;
+	}
+	[pool drain];
+	
+	NSConditionLock* completionLock = chunk.completionLock;
+	[completionLock lock];
+	[completionLock unlockWithCondition:[completionLock condition] + 1];
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Utility Methods
 
@@ -245,6 +618,21 @@ static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatP
 	return [[model class] elementToPropertyMappings];
 }
 
+// Plans are compiled lazily for classes mapped without being registered. Mapping
+// may happen on several threads at once, so access to the cache is serialized
+- (RKObjectMappingPlan*)mappingPlanForClass:(Class)class {
+	RKObjectMappingPlan* plan = nil;
+	@synchronized(_mappingPlans) {
+		plan = [_mappingPlans objectForKey:class];
+		if (nil == plan) {
+			plan = [RKObjectMappingPlan mappingPlanForClass:class inspector:_inspector];
+			[_mappingPlans setObject:plan forKey:class];
+		}
+	}
+	
+	return plan;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Persistent Instance Finders
 
@@ -270,6 +658,40 @@ static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatP
 	return object;
 }
 
+// Resolves the primary keys of every managed object in a collection with batched fetches up front,
+// so findOrCreateInstanceOfModelClass:fromElements: does not fetch once per element. When no class
+// is given, each element is expected to be namespaced by a registered element name
+- (void)findInstancesOfModelClass:(Class)class fromArrayOfElements:(id)array {
+	NSMutableDictionary* primaryKeyValuesByClass = [NSMutableDictionary dictionary];
+	NSMutableDictionary* primaryKeyElementsByClass = [NSMutableDictionary dictionary];
+	for (id element in array) {
+		id elements = nil;
+		Class elementClass = [self classOfElement:element mappedToClass:class elements:&elements];
+		if (NO == [elementClass isSubclassOfClass:[RKManagedObject class]] || NO == [elements isKindOfClass:[NSDictionary class]]) {
+			continue;
+		}
+		
+		NSString* primaryKeyElement = [primaryKeyElementsByClass objectForKey:elementClass];
+		NSMutableArray* primaryKeyValues = [primaryKeyValuesByClass objectForKey:elementClass];
+		if (nil == primaryKeyElement) {
+			primaryKeyElement = [elementClass performSelector:@selector(primaryKeyElement)];
+			[primaryKeyElementsByClass setObject:primaryKeyElement forKey:elementClass];
+			primaryKeyValues = [NSMutableArray array];
+			[primaryKeyValuesByClass setObject:primaryKeyValues forKey:elementClass];
+		}
+		
+		id primaryKeyValue = [elements objectForKey:primaryKeyElement];
+		if (primaryKeyValue && primaryKeyValue != [NSNull null]) {
+			[primaryKeyValues addObject:primaryKeyValue];
+		}
+	}
+	
+	RKManagedObjectStore* objectStore = [[RKObjectManager sharedManager] objectStore];
+	for (Class elementClass in primaryKeyValuesByClass) {
+		[objectStore findInstancesOfManagedObject:elementClass withPrimaryKeyValues:[primaryKeyValuesByClass objectForKey:elementClass]];
+	}
+}
+
 - (id)createOrUpdateInstanceOfModelClass:(Class)class fromElements:(NSDictionary*)elements {
 	id model = [self findOrCreateInstanceOfModelClass:class fromElements:elements];
 	[self updateModel:model fromElements:elements];
@@ -279,30 +701,50 @@ static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatP
 ///////////////////////////////////////////////////////////////////////////////
 // Property & Relationship Manipulation
 
-- (void)updateModel:(id)model ifNewPropertyValue:(id)propertyValue forPropertyNamed:(NSString*)propertyName {	
-	id currentValue = [model valueForKey:propertyName];
+- (void)updateModel:(id)model ifNewPropertyValue:(id)propertyValue forPropertyNamed:(NSString*)propertyName {
+	RKObjectPropertyMapping* propertyMapping = [[self mappingPlanForClass:[model class]] mappingForPropertyNamed:propertyName];
+	if (propertyMapping) {
+		[self updateModel:model ifNewPropertyValue:propertyValue forPropertyMapping:propertyMapping];
+		return;
+	}
+
+	// Properties the class does not map are still assignable, they just don't get a cached mapping
+	RKObjectPropertyAttributes* attributes = [[_inspector propertyAttributesForClass:[model class]] objectForKey:propertyName];
+	propertyMapping = [[RKObjectPropertyMapping alloc] initWithElementKeyPath:propertyName
+																 propertyName:propertyName
+																   attributes:attributes
+																  objectClass:[model class]];
+	[self updateModel:model ifNewPropertyValue:propertyValue forPropertyMapping:propertyMapping];
+	[propertyMapping release];
+}
+
+- (void)updateModel:(id)model ifNewPropertyValue:(id)propertyValue forPropertyMapping:(RKObjectPropertyMapping*)propertyMapping {
+	// Scalars are compared and assigned unboxed. Nil still goes through KVC so setNilValueForKey: applies
+	if (propertyMapping.isScalar && nil != propertyValue && propertyValue != (id)kCFNull) {
+		if ([propertyMapping setScalarValue:propertyValue ofObject:model]) {
+			return;
+		}
+	}
+	
+	id currentValue = [propertyMapping valueOfObject:model];
 	if (nil == currentValue && nil == propertyValue) {
 		// Don't set the property, both are nil
 	} else if (nil == propertyValue || [propertyValue isKindOfClass:[NSNull class]]) {
 		// Clear out the value to reset it
-		[model setValue:nil forKey:propertyName];
+		[propertyMapping setValue:nil ofObject:model];
 	} else if (currentValue == nil || [currentValue isKindOfClass:[NSNull class]]) {
 		// Existing value was nil, just set the property and be happy
-		[model setValue:propertyValue forKey:propertyName];
+		[propertyMapping setValue:propertyValue ofObject:model];
 	} else {
-		SEL comparisonSelector;
-		if ([propertyValue isKindOfClass:[NSString class]]) {
-			comparisonSelector = @selector(isEqualToString:);
-		} else if ([propertyValue isKindOfClass:[NSNumber class]]) {
-			comparisonSelector = @selector(isEqualToNumber:);
-		} else if ([propertyValue isKindOfClass:[NSDate class]]) {
-			comparisonSelector = @selector(isEqualToDate:);
-		} else if ([propertyValue isKindOfClass:[NSArray class]]) {
-			comparisonSelector = @selector(isEqualToArray:);
-		} else if ([propertyValue isKindOfClass:[NSDictionary class]]) {
-			comparisonSelector = @selector(isEqualToDictionary:);
+		// Use the selector compiled into the plan when the value matches the declared property type
+		SEL comparisonSelector = NULL;
+		if (propertyMapping.comparisonSelector && [propertyValue isKindOfClass:propertyMapping.propertyClass]) {
+			comparisonSelector = propertyMapping.comparisonSelector;
 		} else {
-			[NSException raise:@"NoComparisonSelectorFound" format:@"You need a comparison selector for %@ (%@)", propertyName, [propertyValue class]];
+			comparisonSelector = RKObjectMappingComparisonSelectorForClass([propertyValue class]);
+		}
+		if (NULL == comparisonSelector) {
+			[NSException raise:@"NoComparisonSelectorFound" format:@"You need a comparison selector for %@ (%@)", propertyMapping.propertyName, [propertyValue class]];
 		}
 		
 		// Comparison magic using function pointers. See this page for details: http://www.red-sweater.com/blog/320/abusing-objective-c-with-class
@@ -312,22 +754,22 @@ static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatP
 		BOOL areEqual = ComparisonSender(currentValue, comparisonSelector, propertyValue);
 		
 		if (NO == areEqual) {
-			[model setValue:propertyValue forKey:propertyName];
+			[propertyMapping setValue:propertyValue ofObject:model];
 		}
 	}
 }
 
 - (void)setPropertiesOfModel:(id)model fromElements:(NSDictionary*)elements {
-	NSDictionary* elementToPropertyMappings = [self elementToPropertyMappingsForModel:model];
-	for (NSString* elementKeyPath in elementToPropertyMappings) {		
+	RKObjectMappingPlan* plan = [self mappingPlanForClass:[model class]];
+	for (RKObjectPropertyMapping* propertyMapping in plan.propertyMappings) {
 		id elementValue = nil;		
 		BOOL setValue = YES;
 		
 		@try {
-			elementValue = [elements valueForKeyPath:elementKeyPath];
+			elementValue = [propertyMapping valueFromElements:elements];
 		}
 		@catch (NSException * e) {
-			NSLog(@"[RestKit] RKModelMapper: Unable to find element at keyPath %@ in elements dictionary for %@. Skipping...", elementKeyPath, [model class]);
+			NSLog(@"[RestKit] RKModelMapper: Unable to find element at keyPath %@ in elements dictionary for %@. Skipping...", propertyMapping.elementKeyPath, [model class]);
 			setValue = NO;
 		}
 		
@@ -339,38 +781,33 @@ static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatP
 		
 		if (setValue) {
 			id propertyValue = elementValue;
-			NSString* propertyName = [elementToPropertyMappings objectForKey:elementKeyPath];
-			Class class = [self typeClassForProperty:propertyName ofClass:[model class]];
 			if (elementValue != (id)kCFNull && nil != elementValue) {
-				if ([class isEqual:[NSDate class]]) {
-					NSDate* date = [self parseDateFromString:(propertyValue)];
+				if (propertyMapping.propertyClass == [NSDate class]) {
+					NSDate* date = [self parseDateFromString:(propertyValue) forPropertyMapping:propertyMapping];
 					propertyValue = [self dateInLocalTime:date];
 				}
 			}
 			
-			[self updateModel:model ifNewPropertyValue:propertyValue forPropertyNamed:propertyName];
+			[self updateModel:model ifNewPropertyValue:propertyValue forPropertyMapping:propertyMapping];
 		}
 	}
 }
 
 - (void)setRelationshipsOfModel:(id)object fromElements:(NSDictionary*)elements {
-	NSDictionary* elementToRelationshipMappings = [[object class] elementToRelationshipMappings];
-	for (NSString* elementKeyPath in elementToRelationshipMappings) {
-		
-		NSString* propertyName = [elementToRelationshipMappings objectForKey:elementKeyPath];
-		
+	RKObjectMappingPlan* plan = [self mappingPlanForClass:[object class]];
+	for (RKObjectPropertyMapping* relationshipMapping in plan.relationshipMappings) {
 		id relationshipElements = nil;
 		@try {
-			relationshipElements = [elements valueForKeyPath:elementKeyPath];
+			relationshipElements = [relationshipMapping valueFromElements:elements];
 		}
 		@catch (NSException* e) {
-			NSLog(@"Caught exception:%@ when trying valueForKeyPath with path:%@ for elements:%@", e, elementKeyPath, elements);
+			NSLog(@"Caught exception:%@ when trying valueForKeyPath with path:%@ for elements:%@", e, relationshipMapping.elementKeyPath, elements);
 		}
 		
 		if ([relationshipElements isKindOfClass:[NSArray class]] || [relationshipElements isKindOfClass:[NSSet class]]) {
 			// NOTE: The last part of the keyPath contains the elementName for the mapped destination class of our children
-			NSArray* componentsOfKeyPath = [elementKeyPath componentsSeparatedByString:@"."];
-			Class class = [_elementToClassMappings objectForKey:[componentsOfKeyPath objectAtIndex:[componentsOfKeyPath count] - 1]];
+			Class class = [_elementToClassMappings objectForKey:relationshipMapping.elementName];
+			[self findInstancesOfModelClass:class fromArrayOfElements:relationshipElements];
 			NSMutableSet* children = [NSMutableSet setWithCapacity:[relationshipElements count]];
 			for (NSDictionary* childElements in relationshipElements) {				
 				id child = [self createOrUpdateInstanceOfModelClass:class fromElements:childElements];		
@@ -381,7 +818,7 @@ static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatP
 
 			// remove children that we don't have in new children NSSet
 			if ([object isKindOfClass:[RKManagedObject class]]) {
-				NSSet* currentChildren = [object valueForKeyPath:propertyName];
+				NSSet* currentChildren = [relationshipMapping valueOfObject:object];
 				for (id currentChild in currentChildren) {
 					if (![children containsObject: currentChild]) {
 						if ([currentChild isKindOfClass: [RKManagedObject class]]) {
@@ -392,12 +829,11 @@ static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatP
 					}
 				}
 			}
-			[object setValue:children forKey:propertyName];
+			[relationshipMapping setValue:children ofObject:object];
 		} else if ([relationshipElements isKindOfClass:[NSDictionary class]]) {
-			NSArray* componentsOfKeyPath = [elementKeyPath componentsSeparatedByString:@"."];
-			Class class = [_elementToClassMappings objectForKey:[componentsOfKeyPath objectAtIndex:[componentsOfKeyPath count] - 1]];
+			Class class = [_elementToClassMappings objectForKey:relationshipMapping.elementName];
 			id child = [self createOrUpdateInstanceOfModelClass:class fromElements:relationshipElements];		
-			[object setValue:child forKey:propertyName];
+			[relationshipMapping setValue:child ofObject:object];
 		}
 	}
 	
@@ -434,39 +870,71 @@ static const NSString* kRKModelMapperMappingFormatParserKey = @"RKMappingFormatP
 ///////////////////////////////////////////////////////////////////////////////
 // Date & Time Helpers
 
-- (NSDate*)parseDateFromString:(NSString*)string { 
-    NSDate* date = nil; 
-    NSDateFormatter* formatter = [[NSDateFormatter alloc] init]; 
-    // TODO: I changed this to local time and it fixes my date issues.     wtf? 
-    [formatter setTimeZone:self.localTimeZone]; 
-    for (NSString* formatString in self.dateFormats) { 
-        [formatter setDateFormat:formatString]; 
-        //Handle .NET unix-style dates 
-        if(formatString == kRKModelMapperNetDateTimeFormatString && string != nil) 
-        { 
-            NSString *ticks = [string substringWithRange:NSMakeRange(6, 10)]; 
-            NSScanner *dateScanner = [NSScanner scannerWithString:ticks]; 
-            double timestamp; 
-            if(!([dateScanner scanDouble:&timestamp])) 
-            { 
-            } 
-            //Produces the date (albeit with no offset) 
-            date = [NSDate dateWithTimeIntervalSince1970:timestamp]; 
-                   // move to local timezone
-                        
-            
-            
-        } 
-        else { 
-            date = [formatter dateFromString:string]; 
-        } 
-        if (date) { 
-            break; 
-        } 
-    } 
-    [formatter release]; 
-    return date; 
-} 
+- (NSDate*)parseDateFromString:(NSString*)string {
+	return [self parseDateFromString:string forPropertyMapping:nil];
+}
+
+- (NSDate*)parseDateFromString:(NSString*)string forPropertyMapping:(RKObjectPropertyMapping*)propertyMapping {
+	NSString* lastMatchedFormat = propertyMapping.lastMatchedDateFormat;
+	if (lastMatchedFormat && [self.dateFormats containsObject:lastMatchedFormat]) {
+		NSDate* date = [self parseDateFromString:string withFormat:lastMatchedFormat];
+		if (date) {
+			return date;
+		}
+	}
+	
+	for (NSString* formatString in self.dateFormats) {
+		if ([formatString isEqualToString:lastMatchedFormat]) {
+			continue;
+		}
+		
+		NSDate* date = [self parseDateFromString:string withFormat:formatString];
+		if (date) {
+			propertyMapping.lastMatchedDateFormat = formatString;
+			return date;
+		}
+	}
+	
+	return nil;
+}
+
+// The built in Rails and .NET formats are parsed directly. NSDateFormatter is only used for custom formats
+- (NSDate*)parseDateFromString:(NSString*)string withFormat:(NSString*)formatString {
+	if ([formatString isEqualToString:(NSString*)kRKModelMapperRailsDateTimeFormatString]) {
+		// The format quotes the Z designator, so timestamps are read in the local time zone like the formatter did
+		return RKDateFromISO8601String(string, self.localTimeZone);
+	} else if ([formatString isEqualToString:(NSString*)kRKModelMapperNetDateTimeFormatString]) {
+		return RKDateFromDotNetString(string);
+	}
+	
+	return [[self dateFormatterForFormat:formatString] dateFromString:string];
+}
+
+// NSDateFormatter is expensive to create and configure and is not thread safe, so each thread
+// keeps one formatter per format string for the lifetime of the thread
+- (NSDateFormatter*)dateFormatterForFormat:(NSString*)formatString {
+	NSMutableDictionary* threadDictionary = [[NSThread currentThread] threadDictionary];
+	NSMutableDictionary* formatters = [threadDictionary objectForKey:kRKModelMapperDateFormattersKey];
+	if (!formatters) {
+		formatters = [NSMutableDictionary dictionary];
+		[threadDictionary setObject:formatters forKey:kRKModelMapperDateFormattersKey];
+	}
+	
+	NSDateFormatter* formatter = [formatters objectForKey:formatString];
+	if (!formatter) {
+		formatter = [[NSDateFormatter alloc] init];
+		[formatter setDateFormat:formatString];
+		[formatters setObject:formatter forKey:formatString];
+		[formatter release];
+	}
+	
+	// TODO: I changed this to local time and it fixes my date issues.     wtf? 
+	if (NO == [[formatter timeZone] isEqualToTimeZone:self.localTimeZone]) {
+		[formatter setTimeZone:self.localTimeZone];
+	}
+	
+	return formatter;
+}
 
 - (NSDate*)dateInLocalTime:(NSDate*)date {
 	 	return date;
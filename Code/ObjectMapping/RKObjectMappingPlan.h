@@ -0,0 +1,187 @@
+//
+//  RKObjectMappingPlan.h
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "RKObjectPropertyInspector.h"
+
+/**
+ * The storage type of a mapped property, decoded from its runtime type encoding
+ */
+typedef enum {
+	RKObjectPropertyTypeUnsupported = 0,
+	RKObjectPropertyTypeObject,
+	RKObjectPropertyTypeChar,
+	RKObjectPropertyTypeUnsignedChar,
+	RKObjectPropertyTypeShort,
+	RKObjectPropertyTypeUnsignedShort,
+	RKObjectPropertyTypeInt,
+	RKObjectPropertyTypeUnsignedInt,
+	RKObjectPropertyTypeLong,
+	RKObjectPropertyTypeUnsignedLong,
+	RKObjectPropertyTypeLongLong,
+	RKObjectPropertyTypeUnsignedLongLong,
+	RKObjectPropertyTypeFloat,
+	RKObjectPropertyTypeDouble,
+	RKObjectPropertyTypeBool
+} RKObjectPropertyType;
+
+/**
+ * Returns the property type for an Objective-C type encoding
+ */
+RKObjectPropertyType RKObjectPropertyTypeForEncoding(const char* typeEncoding);
+
+/**
+ * Returns the selector used to compare two values of the given class for equality,
+ * or NULL when the class has no type specific comparison method
+ */
+SEL RKObjectMappingComparisonSelectorForClass(Class class);
+
+/**
+ * A precompiled mapping from an element in a payload to a property of a mappable class.
+ * The element key path is split once up front and the property accessors, including custom
+ * getters and setters, are resolved to their implementations so that mapping avoids
+ * key-value coding string lookups and the boxing of scalar values.
+ */
+@interface RKObjectPropertyMapping : NSObject {
+	Class _objectClass;
+	NSString* _elementKeyPath;
+	NSArray* _elementKeys;
+	NSString* _elementName;
+	NSString* _propertyName;
+	Class _propertyClass;
+	RKObjectPropertyType _propertyType;
+	SEL _comparisonSelector;
+	SEL _getter;
+	SEL _setter;
+	IMP _getterIMP;
+	IMP _setterIMP;
+	NSString* _lastMatchedDateFormat;
+}
+
+/**
+ * The key path of the mapped value within the payload elements
+ */
+@property (nonatomic, readonly) NSString* elementKeyPath;
+
+/**
+ * The components of the element key path
+ */
+@property (nonatomic, readonly) NSArray* elementKeys;
+
+/**
+ * The last component of the element key path. For relationships, this is the element
+ * name the destination class is registered under
+ */
+@property (nonatomic, readonly) NSString* elementName;
+
+/**
+ * The name of the mapped property
+ */
+@property (nonatomic, readonly) NSString* propertyName;
+
+/**
+ * The class of the mapped property, or Nil when the property is not an object type
+ */
+@property (nonatomic, readonly) Class propertyClass;
+
+/**
+ * The storage type of the property
+ */
+@property (nonatomic, readonly) RKObjectPropertyType propertyType;
+
+/**
+ * YES when the property holds a C scalar rather than an object
+ */
+@property (nonatomic, readonly) BOOL isScalar;
+
+/**
+ * The selector used to compare values of the property class, or NULL if there is none
+ */
+@property (nonatomic, readonly) SEL comparisonSelector;
+
+/**
+ * The date format that most recently parsed a value for this property. Payloads
+ * nearly always use a single format per property, so it is tried first
+ */
+@property (retain) NSString* lastMatchedDateFormat;
+
+/**
+ * Initialize a property mapping for a property of objectClass. When attributes is nil, the
+ * property is not a declared property and is accessed through key-value coding
+ */
+- (id)initWithElementKeyPath:(NSString*)elementKeyPath propertyName:(NSString*)propertyName attributes:(RKObjectPropertyAttributes*)attributes objectClass:(Class)objectClass;
+
+/**
+ * Returns the value at the element key path within a parsed payload. Raises an
+ * exception when an intermediate value is not key-value coding compliant for the path
+ */
+- (id)valueFromElements:(NSDictionary*)elements;
+
+/**
+ * Returns the current value of the property on object
+ */
+- (id)valueOfObject:(id)object;
+
+/**
+ * Sets the property on object to value
+ */
+- (void)setValue:(id)value ofObject:(id)object;
+
+/**
+ * Assigns a numeric value to a scalar property by calling its accessors directly, without
+ * boxing the current value. The setter is skipped when the value is unchanged. Returns NO
+ * when the property is not a scalar or its accessors cannot be called directly, in which
+ * case the caller should fall back to setValue:ofObject:
+ */
+- (BOOL)setScalarValue:(id)value ofObject:(id)object;
+
+@end
+
+/**
+ * The compiled element and relationship mappings of a mappable class. Built once
+ * per class and reused for every object of the class the mapper processes.
+ */
+@interface RKObjectMappingPlan : NSObject {
+	Class _objectClass;
+	NSArray* _propertyMappings;
+	NSArray* _relationshipMappings;
+	NSDictionary* _mappingsByPropertyName;
+}
+
+/**
+ * The class this plan maps
+ */
+@property (nonatomic, readonly) Class objectClass;
+
+/**
+ * RKObjectPropertyMapping instances compiled from elementToPropertyMappings
+ */
+@property (nonatomic, readonly) NSArray* propertyMappings;
+
+/**
+ * RKObjectPropertyMapping instances compiled from elementToRelationshipMappings
+ */
+@property (nonatomic, readonly) NSArray* relationshipMappings;
+
+/**
+ * Returns a mapping plan for a class, resolving property types with the inspector
+ */
++ (id)mappingPlanForClass:(Class)objectClass inspector:(RKObjectPropertyInspector*)inspector;
+
+/**
+ * Initialize a mapping plan for a class, resolving property types with the inspector
+ */
+- (id)initWithClass:(Class)objectClass inspector:(RKObjectPropertyInspector*)inspector;
+
+/**
+ * Returns the property or relationship mapping that assigns the named property, or nil
+ * when the class does not map it
+ */
+- (RKObjectPropertyMapping*)mappingForPropertyNamed:(NSString*)propertyName;
+
+@end
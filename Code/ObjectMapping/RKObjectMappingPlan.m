@@ -0,0 +1,263 @@
+//
+//  RKObjectMappingPlan.m
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import <objc/runtime.h>
+
+#import "RKObjectMappingPlan.h"
+#import "RKObjectMappable.h"
+
+RKObjectPropertyType RKObjectPropertyTypeForEncoding(const char* typeEncoding) {
+	if (NULL == typeEncoding) {
+		return RKObjectPropertyTypeUnsupported;
+	}
+
+	switch (typeEncoding[0]) {
+		case _C_ID:			return RKObjectPropertyTypeObject;
+		case _C_CHR:		return RKObjectPropertyTypeChar;
+		case _C_UCHR:		return RKObjectPropertyTypeUnsignedChar;
+		case _C_SHT:		return RKObjectPropertyTypeShort;
+		case _C_USHT:		return RKObjectPropertyTypeUnsignedShort;
+		case _C_INT:		return RKObjectPropertyTypeInt;
+		case _C_UINT:		return RKObjectPropertyTypeUnsignedInt;
+		case _C_LNG:		return RKObjectPropertyTypeLong;
+		case _C_ULNG:		return RKObjectPropertyTypeUnsignedLong;
+		case _C_LNG_LNG:	return RKObjectPropertyTypeLongLong;
+		case _C_ULNG_LNG:	return RKObjectPropertyTypeUnsignedLongLong;
+		case _C_FLT:		return RKObjectPropertyTypeFloat;
+		case _C_DBL:		return RKObjectPropertyTypeDouble;
+		// C99 _Bool. BOOL is a signed char on 32-bit iOS and encodes as 'c', so only
+		// properties declared as bool take this branch there
+		case _C_BOOL:		return RKObjectPropertyTypeBool;
+		default:			return RKObjectPropertyTypeUnsupported;
+	}
+}
+
+SEL RKObjectMappingComparisonSelectorForClass(Class class) {
+	if ([class isSubclassOfClass:[NSString class]]) {
+		return @selector(isEqualToString:);
+	} else if ([class isSubclassOfClass:[NSNumber class]]) {
+		return @selector(isEqualToNumber:);
+	} else if ([class isSubclassOfClass:[NSDate class]]) {
+		return @selector(isEqualToDate:);
+	} else if ([class isSubclassOfClass:[NSArray class]]) {
+		return @selector(isEqualToArray:);
+	} else if ([class isSubclassOfClass:[NSDictionary class]]) {
+		return @selector(isEqualToDictionary:);
+	}
+
+	return NULL;
+}
+
+@implementation RKObjectPropertyMapping
+
+@synthesize elementKeyPath = _elementKeyPath;
+@synthesize elementKeys = _elementKeys;
+@synthesize elementName = _elementName;
+@synthesize propertyName = _propertyName;
+@synthesize propertyClass = _propertyClass;
+@synthesize propertyType = _propertyType;
+@synthesize comparisonSelector = _comparisonSelector;
+@synthesize lastMatchedDateFormat = _lastMatchedDateFormat;
+
+- (id)initWithElementKeyPath:(NSString*)elementKeyPath propertyName:(NSString*)propertyName attributes:(RKObjectPropertyAttributes*)attributes objectClass:(Class)objectClass {
+	if ((self = [self init])) {
+		_objectClass = objectClass;
+		_elementKeyPath = [elementKeyPath copy];
+		_propertyName = [propertyName copy];
+		_propertyClass = attributes.propertyClass;
+		_comparisonSelector = RKObjectMappingComparisonSelectorForClass(_propertyClass);
+
+		// Collection operators (@count, @sum, ...) only work through KVC, so keep those paths whole
+		if ([elementKeyPath rangeOfString:@"@"].location == NSNotFound) {
+			_elementKeys = [[elementKeyPath componentsSeparatedByString:@"."] retain];
+		}
+		_elementName = [[[elementKeyPath componentsSeparatedByString:@"."] lastObject] copy];
+
+		// Keys that are not declared properties are left entirely to KVC
+		_propertyType = RKObjectPropertyTypeObject;
+		if (attributes) {
+			_propertyType = RKObjectPropertyTypeForEncoding([attributes.typeEncoding UTF8String]);
+			if (NO == attributes.isReadOnly && _propertyType != RKObjectPropertyTypeUnsupported &&
+				[objectClass instancesRespondToSelector:attributes.getter] && [objectClass instancesRespondToSelector:attributes.setter]) {
+				_getter = attributes.getter;
+				_setter = attributes.setter;
+				_getterIMP = [objectClass instanceMethodForSelector:_getter];
+				_setterIMP = [objectClass instanceMethodForSelector:_setter];
+			}
+		}
+	}
+
+	return self;
+}
+
+- (void)dealloc {
+	[_elementKeyPath release];
+	[_elementKeys release];
+	[_elementName release];
+	[_propertyName release];
+	[_lastMatchedDateFormat release];
+	[super dealloc];
+}
+
+- (id)valueFromElements:(NSDictionary*)elements {
+	if (nil == _elementKeys) {
+		return [elements valueForKeyPath:_elementKeyPath];
+	}
+
+	id value = elements;
+	for (NSString* key in _elementKeys) {
+		if ([value isKindOfClass:[NSDictionary class]]) {
+			value = [(NSDictionary*)value objectForKey:key];
+		} else {
+			value = [value valueForKey:key];
+		}
+
+		if (nil == value) {
+			break;
+		}
+	}
+
+	return value;
+}
+
+// The cached implementations are only valid for instances of the exact class the plan was
+// compiled for. Subclasses may override the accessors and key-value observed instances have
+// their class swapped out, so those go through KVC
+- (BOOL)canUseAccessorsOfObject:(id)object {
+	return (_getterIMP && object_getClass(object) == _objectClass);
+}
+
+- (BOOL)isScalar {
+	return (_propertyType != RKObjectPropertyTypeObject && _propertyType != RKObjectPropertyTypeUnsupported);
+}
+
+- (id)valueOfObject:(id)object {
+	if (_propertyType == RKObjectPropertyTypeObject && [self canUseAccessorsOfObject:object]) {
+		return _getterIMP(object, _getter);
+	}
+
+	return [object valueForKey:_propertyName];
+}
+
+- (void)setValue:(id)value ofObject:(id)object {
+	if (_propertyType == RKObjectPropertyTypeObject && [self canUseAccessorsOfObject:object]) {
+		_setterIMP(object, _setter, value);
+	} else {
+		[object setValue:value forKey:_propertyName];
+	}
+}
+
+// Calls the getter and setter through function pointers typed for the scalar, so no NSNumber
+// is created for the current value and the setter only runs when the value actually changes
+#define RKSetScalarIfChanged(type, newValue) { \
+	type scalar = (type)(newValue); \
+	type (*getter)(id, SEL) = (type (*)(id, SEL))_getterIMP; \
+	if (getter(object, _getter) != scalar) { \
+		void (*setter)(id, SEL, type) = (void (*)(id, SEL, type))_setterIMP; \
+		setter(object, _setter, scalar); \
+	} \
+	return YES; \
+}
+
+- (BOOL)setScalarValue:(id)value ofObject:(id)object {
+	if (NO == [self isScalar] || NO == [self canUseAccessorsOfObject:object]) {
+		return NO;
+	}
+	// JSON numbers arrive as NSNumber, but numeric strings convert the same way under KVC
+	if (NO == [value respondsToSelector:@selector(longLongValue)] || NO == [value respondsToSelector:@selector(doubleValue)]) {
+		return NO;
+	}
+
+	switch (_propertyType) {
+		case RKObjectPropertyTypeChar:				RKSetScalarIfChanged(char, [value longLongValue]);
+		case RKObjectPropertyTypeUnsignedChar:		RKSetScalarIfChanged(unsigned char, [value longLongValue]);
+		case RKObjectPropertyTypeShort:				RKSetScalarIfChanged(short, [value longLongValue]);
+		case RKObjectPropertyTypeUnsignedShort:		RKSetScalarIfChanged(unsigned short, [value longLongValue]);
+		case RKObjectPropertyTypeInt:				RKSetScalarIfChanged(int, [value longLongValue]);
+		case RKObjectPropertyTypeUnsignedInt:		RKSetScalarIfChanged(unsigned int, [value longLongValue]);
+		case RKObjectPropertyTypeLong:				RKSetScalarIfChanged(long, [value longLongValue]);
+		case RKObjectPropertyTypeUnsignedLong:		RKSetScalarIfChanged(unsigned long, [value longLongValue]);
+		case RKObjectPropertyTypeLongLong:			RKSetScalarIfChanged(long long, [value longLongValue]);
+		case RKObjectPropertyTypeUnsignedLongLong:	RKSetScalarIfChanged(unsigned long long, [value longLongValue]);
+		case RKObjectPropertyTypeFloat:				RKSetScalarIfChanged(float, [value doubleValue]);
+		case RKObjectPropertyTypeDouble:			RKSetScalarIfChanged(double, [value doubleValue]);
+		case RKObjectPropertyTypeBool:				RKSetScalarIfChanged(bool, [value boolValue]);
+		default:									return NO;
+	}
+}
+
+@end
+
+@implementation RKObjectMappingPlan
+
+@synthesize objectClass = _objectClass;
+@synthesize propertyMappings = _propertyMappings;
+@synthesize relationshipMappings = _relationshipMappings;
+
++ (id)mappingPlanForClass:(Class)objectClass inspector:(RKObjectPropertyInspector*)inspector {
+	return [[[self alloc] initWithClass:objectClass inspector:inspector] autorelease];
+}
+
+- (id)initWithClass:(Class)objectClass inspector:(RKObjectPropertyInspector*)inspector {
+	if ((self = [self init])) {
+		_objectClass = objectClass;
+
+		NSDictionary* propertyAttributes = [inspector propertyAttributesForClass:objectClass];
+		NSMutableArray* propertyMappings = [NSMutableArray array];
+		if ([objectClass respondsToSelector:@selector(elementToPropertyMappings)]) {
+			NSDictionary* elementToPropertyMappings = [objectClass elementToPropertyMappings];
+			for (NSString* elementKeyPath in elementToPropertyMappings) {
+				NSString* propertyName = [elementToPropertyMappings objectForKey:elementKeyPath];
+				RKObjectPropertyMapping* mapping = [[RKObjectPropertyMapping alloc] initWithElementKeyPath:elementKeyPath
+																							  propertyName:propertyName
+																								attributes:[propertyAttributes objectForKey:propertyName]
+																							   objectClass:objectClass];
+				[propertyMappings addObject:mapping];
+				[mapping release];
+			}
+		}
+
+		NSMutableArray* relationshipMappings = [NSMutableArray array];
+		if ([objectClass respondsToSelector:@selector(elementToRelationshipMappings)]) {
+			NSDictionary* elementToRelationshipMappings = [objectClass elementToRelationshipMappings];
+			for (NSString* elementKeyPath in elementToRelationshipMappings) {
+				NSString* propertyName = [elementToRelationshipMappings objectForKey:elementKeyPath];
+				RKObjectPropertyMapping* mapping = [[RKObjectPropertyMapping alloc] initWithElementKeyPath:elementKeyPath
+																							  propertyName:propertyName
+																								attributes:[propertyAttributes objectForKey:propertyName]
+																							   objectClass:objectClass];
+				[relationshipMappings addObject:mapping];
+				[mapping release];
+			}
+		}
+
+		_propertyMappings = [propertyMappings copy];
+		_relationshipMappings = [relationshipMappings copy];
+
+		NSMutableDictionary* mappingsByPropertyName = [NSMutableDictionary dictionaryWithCapacity:[_propertyMappings count] + [_relationshipMappings count]];
+		for (RKObjectPropertyMapping* mapping in [_propertyMappings arrayByAddingObjectsFromArray:_relationshipMappings]) {
+			[mappingsByPropertyName setObject:mapping forKey:mapping.propertyName];
+		}
+		_mappingsByPropertyName = [mappingsByPropertyName copy];
+	}
+
+	return self;
+}
+
+- (void)dealloc {
+	[_propertyMappings release];
+	[_relationshipMappings release];
+	[_mappingsByPropertyName release];
+	[super dealloc];
+}
+
+- (RKObjectPropertyMapping*)mappingForPropertyNamed:(NSString*)propertyName {
+	return [_mappingsByPropertyName objectForKey:propertyName];
+}
+
+@end
@@ -0,0 +1,72 @@
+//
+//  RKObjectMappingQueue.h
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * A fixed set of long-lived worker threads that object loaders hand their mapping work to.
+ * Each worker keeps its thread local state (managed object context, parser, date formatters)
+ * warm from one response to the next rather than building it for a new thread every time.
+ *
+ * The queue applies backpressure when saturated: a background thread submitting work waits until
+ * the number of pending operations drops below maxPendingOperations. The main thread is never
+ * blocked. Its submissions are deferred instead, and workers admit them in submission order as
+ * room frees up, so the number of pending operations stays bounded for every submitter.
+ */
+@interface RKObjectMappingQueue : NSObject {
+	NSCondition* _condition;
+	NSMutableArray* _operations;
+	NSMutableArray* _deferredOperations;
+	NSUInteger _numberOfThreads;
+	NSUInteger _numberOfStartedThreads;
+	NSUInteger _maxPendingOperations;
+}
+
+/**
+ * The number of worker threads
+ */
+@property (nonatomic, readonly) NSUInteger numberOfThreads;
+
+/**
+ * The number of operations that may wait for a worker before background submitters are blocked
+ */
+@property (nonatomic, readonly) NSUInteger maxPendingOperations;
+
+/**
+ * The number of operations waiting for a worker
+ */
+@property (nonatomic, readonly) NSUInteger pendingOperationCount;
+
+/**
+ * The number of operations submitted from the main thread that are waiting for room in the queue
+ */
+@property (nonatomic, readonly) NSUInteger deferredOperationCount;
+
+/**
+ * YES when the number of waiting operations has reached maxPendingOperations
+ */
+@property (nonatomic, readonly) BOOL isSaturated;
+
+/**
+ * Returns the queue used by object loaders, with one worker thread per active processor
+ */
++ (RKObjectMappingQueue*)sharedQueue;
+
+/**
+ * Initialize a queue with a number of worker threads. The threads are started on demand and
+ * run for the lifetime of the process
+ */
+- (id)initWithNumberOfThreads:(NSUInteger)numberOfThreads maxPendingOperations:(NSUInteger)maxPendingOperations;
+
+/**
+ * Sends selector to target with object on one of the worker threads. Both target and object
+ * are retained until the operation has run
+ */
+- (void)addOperationWithTarget:(id)target selector:(SEL)selector object:(id)object;
+
+@end
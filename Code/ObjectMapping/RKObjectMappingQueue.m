@@ -0,0 +1,144 @@
+//
+//  RKObjectMappingQueue.m
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import "RKObjectMappingQueue.h"
+
+static RKObjectMappingQueue* sharedQueue = nil;
+
+@interface RKObjectMappingQueue (Private)
+- (void)workerMain;
+- (void)admitDeferredOperations;
+@end
+
+@implementation RKObjectMappingQueue
+
+@synthesize numberOfThreads = _numberOfThreads;
+@synthesize maxPendingOperations = _maxPendingOperations;
+
++ (RKObjectMappingQueue*)sharedQueue {
+	@synchronized(self) {
+		if (nil == sharedQueue) {
+			NSUInteger numberOfThreads = MAX([[NSProcessInfo processInfo] activeProcessorCount], 1);
+			sharedQueue = [[RKObjectMappingQueue alloc] initWithNumberOfThreads:numberOfThreads maxPendingOperations:numberOfThreads * 2];
+		}
+	}
+
+	return sharedQueue;
+}
+
+- (id)initWithNumberOfThreads:(NSUInteger)numberOfThreads maxPendingOperations:(NSUInteger)maxPendingOperations {
+	if ((self = [self init])) {
+		_condition = [[NSCondition alloc] init];
+		_operations = [[NSMutableArray alloc] init];
+		_deferredOperations = [[NSMutableArray alloc] init];
+		_numberOfThreads = MAX(numberOfThreads, 1);
+		_numberOfStartedThreads = 0;
+		_maxPendingOperations = MAX(maxPendingOperations, 1);
+	}
+
+	return self;
+}
+
+- (void)dealloc {
+	[_condition release];
+	[_operations release];
+	[_deferredOperations release];
+	[super dealloc];
+}
+
+- (NSUInteger)pendingOperationCount {
+	[_condition lock];
+	NSUInteger count = [_operations count];
+	[_condition unlock];
+	return count;
+}
+
+- (NSUInteger)deferredOperationCount {
+	[_condition lock];
+	NSUInteger count = [_deferredOperations count];
+	[_condition unlock];
+	return count;
+}
+
+- (BOOL)isSaturated {
+	return [self pendingOperationCount] >= _maxPendingOperations;
+}
+
+- (void)addOperationWithTarget:(id)target selector:(SEL)selector object:(id)object {
+	NSMethodSignature* signature = [target methodSignatureForSelector:selector];
+	NSInvocation* invocation = [NSInvocation invocationWithMethodSignature:signature];
+	[invocation setTarget:target];
+	[invocation setSelector:selector];
+	if ([signature numberOfArguments] > 2) {
+		[invocation setArgument:&object atIndex:2];
+	}
+	[invocation retainArguments];
+
+	[_condition lock];
+	if ([NSThread isMainThread]) {
+		// Operations deferred earlier go first, so the main thread's work keeps its order
+		if ([_deferredOperations count] > 0 || [_operations count] >= _maxPendingOperations) {
+			[_deferredOperations addObject:invocation];
+		} else {
+			[_operations addObject:invocation];
+		}
+	} else {
+		while ([_operations count] >= _maxPendingOperations) {
+			[_condition wait];
+		}
+		[_operations addObject:invocation];
+	}
+
+	// Workers are started as work arrives, up to numberOfThreads
+	if (_numberOfStartedThreads < _numberOfThreads) {
+		_numberOfStartedThreads++;
+		[NSThread detachNewThreadSelector:@selector(workerMain) toTarget:self withObject:nil];
+	}
+	[_condition broadcast];
+	[_condition unlock];
+}
+
+// Moves deferred operations into the freed room. Must be called with the condition locked
+- (void)admitDeferredOperations {
+	while ([_deferredOperations count] > 0 && [_operations count] < _maxPendingOperations) {
+		[_operations addObject:[_deferredOperations objectAtIndex:0]];
+		[_deferredOperations removeObjectAtIndex:0];
+	}
+}
+
+- (void)workerMain {
+	// Workers run for the lifetime of the process, so their outermost pool is never drained
+	[[NSAutoreleasePool alloc] init];
+	[[NSThread currentThread] setName:@"org.restkit.object-mapping"];
+
+	while (YES) {
+		[_condition lock];
+		while ([_operations count] == 0) {
+			[_condition wait];
+		}
+		NSInvocation* invocation = [[_operations objectAtIndex:0] retain];
+		[_operations removeObjectAtIndex:0];
+		[self admitDeferredOperations];
+		// Wake any submitters waiting for room in the queue
+		[_condition broadcast];
+		[_condition unlock];
+
+		NSAutoreleasePool* pool = [[NSAutoreleasePool alloc] init];
+		@try {
+			[invocation invoke];
+		}
+		@catch (NSException* e) {
+			// Operations report their own failures; this only keeps the worker alive
+			NSLog(@"[RestKit] RKObjectMappingQueue: Exception (%@) raised while performing %@ on %@", [e reason], NSStringFromSelector([invocation selector]), [invocation target]);
+		}
+		[pool drain];
+		[invocation release];
+	}
+}
+
+@end
@@ -8,14 +8,97 @@
 
 #import <Foundation/Foundation.h>
 
+/**
+ * The declared attributes of a single property, as reported by property_getAttributes
+ */
+@interface RKObjectPropertyAttributes : NSObject {
+	NSString* _name;
+	NSString* _typeEncoding;
+	Class _propertyClass;
+	NSString* _ivarName;
+	SEL _getter;
+	SEL _setter;
+	BOOL _isReadOnly;
+	BOOL _isDynamic;
+}
+
+/**
+ * The name of the property
+ */
+@property (nonatomic, readonly) NSString* name;
+
+/**
+ * The Objective-C type encoding of the property, such as @"NSString" or i
+ */
+@property (nonatomic, readonly) NSString* typeEncoding;
+
+/**
+ * The class of an object property, or Nil for scalars and properties declared as id
+ */
+@property (nonatomic, readonly) Class propertyClass;
+
+/**
+ * The name of the instance variable backing a synthesized property, or nil
+ */
+@property (nonatomic, readonly) NSString* ivarName;
 
+/**
+ * The getter selector, taking a custom getter= attribute into account
+ */
+@property (nonatomic, readonly) SEL getter;
+
+/**
+ * The setter selector, taking a custom setter= attribute into account. NULL for readonly properties
+ */
+@property (nonatomic, readonly) SEL setter;
+
+/**
+ * YES when the property was declared readonly
+ */
+@property (nonatomic, readonly) BOOL isReadOnly;
+
+/**
+ * YES when the property was declared @dynamic
+ */
+@property (nonatomic, readonly) BOOL isDynamic;
+
+/**
+ * YES when the property holds an object rather than a C scalar
+ */
+@property (nonatomic, readonly) BOOL isObject;
+
+/**
+ * Initialize with the name and attribute string of a runtime property
+ */
+- (id)initWithName:(NSString*)name attributeString:(NSString*)attributeString;
+
+@end
+
+/**
+ * Introspects and caches the properties of classes. The cache is safe to use from several
+ * threads at once: lookups of classes that have already been inspected never take a lock, and
+ * the properties of each class are published exactly once and shared by every caller.
+ */
 @interface RKObjectPropertyInspector : NSObject {
-	NSMutableDictionary* _cachedPropertyNamesAndTypes;
+	NSDictionary* volatile _propertyAttributesByClass;
+	NSDictionary* volatile _propertyNamesAndTypesByClass;
+	NSMutableArray* _retiredCaches;
 }
 
+/**
+ * Returns the inspector shared by all object mappers
+ */
++ (RKObjectPropertyInspector*)sharedInspector;
+
 /**
  * Returns a dictionary of names and types for the properties of a given class
  */
 - (NSDictionary *)propertyNamesAndTypesForClass:(Class)class;
 
+/**
+ * Returns a dictionary of property names to RKObjectPropertyAttributes for the properties
+ * of a given class, including those inherited from its superclasses
+ */
+- (NSDictionary*)propertyAttributesForClass:(Class)class;
+
 @end
@@ -7,80 +7,222 @@
 //
 
 #import <objc/message.h>
+#import <libkern/OSAtomic.h>
 
 #import "RKObjectPropertyInspector.h"
 
+static RKObjectPropertyInspector* sharedInspector = nil;
+
+@implementation RKObjectPropertyAttributes
+
+@synthesize name = _name;
+@synthesize typeEncoding = _typeEncoding;
+@synthesize propertyClass = _propertyClass;
+@synthesize ivarName = _ivarName;
+@synthesize getter = _getter;
+@synthesize setter = _setter;
+@synthesize isReadOnly = _isReadOnly;
+@synthesize isDynamic = _isDynamic;
+
+// See: http://developer.apple.com/mac/library/DOCUMENTATION/Cocoa/Conceptual/ObjCRuntimeGuide/Articles/ocrtPropertyIntrospection.html#//apple_ref/doc/uid/TP40008048-CH101-SW5
+- (id)initWithName:(NSString*)name attributeString:(NSString*)attributeString {
+	if ((self = [self init])) {
+		_name = [name copy];
+		NSString* getterName = name;
+		NSString* setterName = nil;
+
+		for (NSString* attribute in [attributeString componentsSeparatedByString:@","]) {
+			if ([attribute length] == 0) {
+				continue;
+			}
+
+			NSString* value = [attribute substringFromIndex:1];
+			switch ([attribute characterAtIndex:0]) {
+				case 'T':
+					[_typeEncoding release];
+					_typeEncoding = [value copy];
+					break;
+				case 'V':
+					[_ivarName release];
+					_ivarName = [value copy];
+					break;
+				case 'G':
+					getterName = value;
+					break;
+				case 'S':
+					setterName = value;
+					break;
+				case 'R':
+					_isReadOnly = YES;
+					break;
+				case 'D':
+					_isDynamic = YES;
+					break;
+				default:
+					break;
+			}
+		}
+
+		// Object types are encoded as @"ClassName" or @"ClassName<Protocol>"; a bare @ is id
+		if ([_typeEncoding hasPrefix:@"@\""] && [_typeEncoding length] > 3) {
+			NSString* className = [_typeEncoding substringWithRange:NSMakeRange(2, [_typeEncoding length] - 3)];
+			NSRange protocolRange = [className rangeOfString:@"<"];
+			if (protocolRange.location != NSNotFound) {
+				className = [className substringToIndex:protocolRange.location];
+			}
+			if ([className length] > 0) {
+				_propertyClass = objc_getClass([className UTF8String]);
+			}
+		}
+
+		_getter = NSSelectorFromString(getterName);
+		if (NO == _isReadOnly) {
+			if (nil == setterName && [name length] > 0) {
+				setterName = [NSString stringWithFormat:@"set%@%@:", [[name substringToIndex:1] uppercaseString], [name substringFromIndex:1]];
+			}
+			_setter = NSSelectorFromString(setterName);
+		}
+	}
+
+	return self;
+}
+
+- (void)dealloc {
+	[_name release];
+	[_typeEncoding release];
+	[_ivarName release];
+	[super dealloc];
+}
+
+- (BOOL)isObject {
+	return [_typeEncoding hasPrefix:@"@"];
+}
+
+- (NSString*)description {
+	return [NSString stringWithFormat:@"<%@: %@ (%@)>", NSStringFromClass([self class]), _name, _typeEncoding];
+}
+
+@end
+
 @implementation RKObjectPropertyInspector
 
++ (RKObjectPropertyInspector*)sharedInspector {
+	@synchronized(self) {
+		if (nil == sharedInspector) {
+			sharedInspector = [[RKObjectPropertyInspector alloc] init];
+		}
+	}
+
+	return sharedInspector;
+}
+
 - (id)init {
 	if (self = [super init]) {
-		_cachedPropertyNamesAndTypes = [[NSMutableDictionary alloc] init];
+		_propertyAttributesByClass = [[NSDictionary alloc] init];
+		_propertyNamesAndTypesByClass = [[NSDictionary alloc] init];
+		_retiredCaches = [[NSMutableArray alloc] init];
 	}
-	
+
 	return self;
 }
 
 - (void)dealloc {
-	[_cachedPropertyNamesAndTypes release];
+	[_propertyAttributesByClass release];
+	[_propertyNamesAndTypesByClass release];
+	[_retiredCaches release];
 	[super dealloc];
 }
 
-- (NSString*)propertyTypeFromAttributeString:(NSString*)attributeString {
-	NSString *type = [NSString string];
-	NSScanner *typeScanner = [NSScanner scannerWithString:attributeString];
-	[typeScanner scanUpToCharactersFromSet:[NSCharacterSet characterSetWithCharactersInString:@"@"] intoString:NULL];
-	
-	// we are not dealing with an object
-	if([typeScanner isAtEnd]) {
-		return @"NULL";
+// The caches are immutable dictionaries that are replaced wholesale when a class is added.
+// Readers load the current dictionary without locking or writing shared state, and never see
+// it change underneath them. Replaced dictionaries are kept alive for the life of the inspector,
+// so a reader still using one can never have it freed. Cached objects are carried into every
+// later dictionary, so they outlive the lookup
+- (id)cachedObjectForClass:(Class)class inCache:(NSDictionary* volatile*)cache {
+	NSDictionary* snapshot = *cache;
+	return [snapshot objectForKey:class];
+}
+
+// Publishes the object for a class unless another thread got there first, in which case the
+// already published object is returned so every caller shares a single instance per class
+- (id)publishObject:(id)object forClass:(Class)class inCache:(NSDictionary* volatile*)cache {
+	@synchronized(self) {
+		NSDictionary* snapshot = *cache;
+		id publishedObject = [snapshot objectForKey:class];
+		if (publishedObject) {
+			return publishedObject;
+		}
+
+		NSMutableDictionary* mutableSnapshot = [snapshot mutableCopy];
+		[mutableSnapshot setObject:object forKey:class];
+		NSDictionary* newSnapshot = [mutableSnapshot copy];
+		[mutableSnapshot release];
+
+		OSMemoryBarrier();
+		*cache = newSnapshot;
+
+		// Readers may still be using the previous dictionary, so it is retired rather than released.
+		// Only one dictionary is retired per inspected class, which keeps the retired set small
+		[_retiredCaches addObject:snapshot];
+		[snapshot release];
 	}
-	[typeScanner scanCharactersFromSet:[NSCharacterSet characterSetWithCharactersInString:@"\"@"] intoString:NULL];
-	// this gets the actual object type
-	[typeScanner scanUpToCharactersFromSet:[NSCharacterSet characterSetWithCharactersInString:@"\""] intoString:&type];
-	return type;
+
+	return object;
 }
 
-- (NSDictionary *)propertyNamesAndTypesForClass:(Class)class {
-	NSMutableDictionary* propertyNames = [_cachedPropertyNamesAndTypes objectForKey:class];
-	if (propertyNames) {
-		return propertyNames;
+- (NSDictionary*)propertyAttributesForClass:(Class)class {
+	NSDictionary* propertyAttributes = [self cachedObjectForClass:class inCache:&_propertyAttributesByClass];
+	if (propertyAttributes) {
+		return propertyAttributes;
 	}
-	propertyNames = [NSMutableDictionary dictionary];
-	
+
+	NSMutableDictionary* attributesByName = [NSMutableDictionary dictionary];
+
 	//include superclass properties
 	Class currentClass = class;
 	while (currentClass != nil) {
 		// Get the raw list of properties
 		unsigned int outCount;
 		objc_property_t *propList = class_copyPropertyList(currentClass, &outCount);
-		
-		// Collect the property names
-		int i;
-		NSString *propName;
+
+		unsigned int i;
 		for (i = 0; i < outCount; i++) {
-			// TODO: Add support for custom getter and setter methods
-			// property_getAttributes() returns everything we need to implement this...
-			// See: http://developer.apple.com/mac/library/DOCUMENTATION/Cocoa/Conceptual/ObjCRuntimeGuide/Articles/ocrtPropertyIntrospection.html#//apple_ref/doc/uid/TP40008048-CH101-SW5
 			objc_property_t* prop = propList + i;
-			NSString* attributeString = [NSString stringWithCString:property_getAttributes(*prop) encoding:NSUTF8StringEncoding];			
-			propName = [NSString stringWithCString:property_getName(*prop) encoding:NSUTF8StringEncoding];
-			
-			if (![propName isEqualToString:@"_mapkit_hasPanoramaID"]) {
-				const char* className = [[self propertyTypeFromAttributeString:attributeString] cStringUsingEncoding:NSUTF8StringEncoding];
-				Class class = objc_getClass(className);
-				// TODO: Use an id type if unable to get the class??
-				if (class) {
-					[propertyNames setObject:class forKey:propName];
-				}
+			NSString* propName = [NSString stringWithCString:property_getName(*prop) encoding:NSUTF8StringEncoding];
+
+			// Redeclarations in a subclass take precedence over the superclass
+			if (![propName isEqualToString:@"_mapkit_hasPanoramaID"] && nil == [attributesByName objectForKey:propName]) {
+				NSString* attributeString = [NSString stringWithCString:property_getAttributes(*prop) encoding:NSUTF8StringEncoding];
+				RKObjectPropertyAttributes* attributes = [[RKObjectPropertyAttributes alloc] initWithName:propName attributeString:attributeString];
+				[attributesByName setObject:attributes forKey:propName];
+				[attributes release];
 			}
 		}
-		
+
 		free(propList);
 		currentClass = [currentClass superclass];
 	}
-	
-	[_cachedPropertyNamesAndTypes setObject:propertyNames forKey:class];	
-	return propertyNames;
+
+	return [self publishObject:[NSDictionary dictionaryWithDictionary:attributesByName] forClass:class inCache:&_propertyAttributesByClass];
+}
+
+- (NSDictionary *)propertyNamesAndTypesForClass:(Class)class {
+	NSDictionary* propertyNames = [self cachedObjectForClass:class inCache:&_propertyNamesAndTypesByClass];
+	if (propertyNames) {
+		return propertyNames;
+	}
+
+	NSMutableDictionary* namesAndTypes = [NSMutableDictionary dictionary];
+	NSDictionary* attributesByName = [self propertyAttributesForClass:class];
+	for (NSString* propName in attributesByName) {
+		Class propertyClass = [[attributesByName objectForKey:propName] propertyClass];
+		// TODO: Use an id type if unable to get the class??
+		if (propertyClass) {
+			[namesAndTypes setObject:propertyClass forKey:propName];
+		}
+	}
+
+	return [self publishObject:[NSDictionary dictionaryWithDictionary:namesAndTypes] forClass:class inCache:&_propertyNamesAndTypesByClass];
 }
 
 @end
@@ -11,5 +11,8 @@ extern NSString* const RKRestKitErrorDomain;
 
 typedef enum {
 	RKObjectLoaderRemoteSystemError = 1,
-	RKRequestBaseURLOfflineError
+	RKRequestBaseURLOfflineError,
+	RKResumableUploadRejectedError,
+	RKObjectLoaderMappingError,
+	RKResponseBodySinkError
 } RKRestKitError;
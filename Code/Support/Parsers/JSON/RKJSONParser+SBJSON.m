@@ -24,6 +24,15 @@
 	return result;
 }
 
+// SBJSON only parses strings, so the payload must be decoded first
+- (id)objectFromData:(NSData*)data {
+	NSString* string = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+	id result = [self objectFromString:string];
+	[string release];
+	
+	return result;
+}
+
 - (NSString*)stringFromObject:(id)object {
 	return [object JSONRepresentation];
 }
@@ -9,6 +9,361 @@
 #import "RKJSONParser.h"
 #import "YAJL.h"
 
+/**
+ * Builds the payload from YAJL parse events, handing the elements of the
+ * collection at keyPath to the delegate instead of collecting them
+ */
+@interface RKJSONStreamingParser : NSObject <RKStreamingParser, YAJLParserDelegate> {
+	YAJLParser* _parser;
+	NSString* _keyPath;
+	NSObject<RKStreamingParserDelegate>* _delegate;
+	id _result;
+	NSError* _error;
+	NSMutableArray* _stack;
+	NSMutableArray* _keyStack;
+	NSMutableArray* _pathStack;
+	NSMutableArray* _streamingArray; // weak; the open collection at keyPath
+	BOOL _isStreaming;
+}
+
+- (id)initWithKeyPath:(NSString*)keyPath delegate:(NSObject<RKStreamingParserDelegate>*)delegate;
+
+@end
+
+@implementation RKJSONStreamingParser
+
+@synthesize keyPath = _keyPath, delegate = _delegate, result = _result;
+
+- (id)initWithKeyPath:(NSString*)keyPath delegate:(NSObject<RKStreamingParserDelegate>*)delegate {
+	if ((self = [self init])) {
+		_parser = [[YAJLParser alloc] initWithParserOptions:YAJLParserOptionsNone];
+		_parser.delegate = self;
+		_keyPath = [keyPath copy];
+		_delegate = delegate;
+		_stack = [[NSMutableArray alloc] init];
+		_keyStack = [[NSMutableArray alloc] init];
+		_pathStack = [[NSMutableArray alloc] init];
+		_streamingArray = nil;
+		_isStreaming = NO;
+	}
+
+	return self;
+}
+
+- (void)dealloc {
+	_parser.delegate = nil;
+	[_parser release];
+	[_keyPath release];
+	[_result release];
+	[_error release];
+	[_stack release];
+	[_keyStack release];
+	[_pathStack release];
+	[super dealloc];
+}
+
+- (BOOL)isStreaming {
+	return _isStreaming;
+}
+
+- (NSError*)error {
+	return (_error ? _error : _parser.parserError);
+}
+
+- (BOOL)parseData:(NSData*)data {
+	return [_parser parse:data] != YAJLParserStatusError;
+}
+
+- (BOOL)finishParsing {
+	// YAJL treats a truncated document as awaiting more data, so check for unclosed containers ourselves
+	if ([_parser parseCompleted] != YAJLParserStatusError && [_stack count] > 0) {
+		NSDictionary* userInfo = [NSDictionary dictionaryWithObject:@"Unexpected end of JSON payload" forKey:NSLocalizedDescriptionKey];
+		_error = [[NSError errorWithDomain:YAJLErrorDomain code:YAJLParserStatusInsufficientData userInfo:userInfo] retain];
+	}
+
+	return (nil == self.error);
+}
+
+#pragma mark Object Assembly
+
+// The key path of a container about to be opened. Containers nested inside of
+// arrays are not addressable by key path and are marked with NSNull
+- (id)pathForNewContainer {
+	if ([_stack count] == 0) {
+		return @"";
+	}
+
+	id parentPath = [_pathStack lastObject];
+	if ([[_stack lastObject] isKindOfClass:[NSArray class]] || parentPath == [NSNull null]) {
+		return [NSNull null];
+	}
+
+	NSString* key = [_keyStack lastObject];
+	return ([parentPath length] == 0) ? key : [NSString stringWithFormat:@"%@.%@", parentPath, key];
+}
+
+- (void)pushContainer:(id)container {
+	id path = [self pathForNewContainer];
+	[_stack addObject:container];
+	[_pathStack addObject:path];
+}
+
+- (void)addValue:(id)value {
+	if ([_stack count] == 0) {
+		[_result release];
+		_result = [value retain];
+		return;
+	}
+
+	id container = [_stack lastObject];
+	if ([container isKindOfClass:[NSArray class]]) {
+		if (container == _streamingArray) {
+			[_delegate parser:self didParseObject:value];
+		} else {
+			[(NSMutableArray*)container addObject:value];
+		}
+	} else {
+		[(NSMutableDictionary*)container setObject:value forKey:[_keyStack lastObject]];
+		[_keyStack removeLastObject];
+	}
+}
+
+- (void)popContainer {
+	id container = [[_stack lastObject] retain];
+	if (container == _streamingArray) {
+		_streamingArray = nil;
+	}
+	[_stack removeLastObject];
+	[_pathStack removeLastObject];
+	[self addValue:container];
+	[container release];
+}
+
+#pragma mark YAJLParserDelegate
+
+- (void)parserDidStartDictionary:(YAJLParser*)parser {
+	NSMutableDictionary* dictionary = [[NSMutableDictionary alloc] init];
+	[self pushContainer:dictionary];
+	[dictionary release];
+}
+
+- (void)parserDidEndDictionary:(YAJLParser*)parser {
+	[self popContainer];
+}
+
+- (void)parserDidStartArray:(YAJLParser*)parser {
+	NSMutableArray* array = [[NSMutableArray alloc] init];
+	[self pushContainer:array];
+	[array release];
+
+	if (_delegate && NO == _isStreaming) {
+		NSString* targetPath = _keyPath ? _keyPath : @"";
+		if ([targetPath isEqual:[_pathStack lastObject]]) {
+			_streamingArray = array;
+			_isStreaming = YES;
+		}
+	}
+}
+
+- (void)parserDidEndArray:(YAJLParser*)parser {
+	[self popContainer];
+}
+
+- (void)parser:(YAJLParser*)parser didMapKey:(NSString*)key {
+	[_keyStack addObject:key];
+}
+
+- (void)parser:(YAJLParser*)parser didAdd:(id)value {
+	[self addValue:value];
+}
+
+@end
+
+/**
+ * Exposes the buffer of the generator without copying it into a string
+ */
+@interface RKJSONGenerator : YAJLGen {
+}
+
+- (void)getBuffer:(const unsigned char**)buffer length:(unsigned int*)length;
+
+@end
+
+@implementation RKJSONGenerator
+
+- (void)getBuffer:(const unsigned char**)buffer length:(unsigned int*)length {
+	rk_yajl_gen_get_buf(gen_, buffer, length);
+}
+
+@end
+
+// The amount of JSON generated ahead of the reader before generation pauses
+static const unsigned int kRKJSONGeneratorStreamChunkSize = 16 * 1024;
+
+/**
+ * Generates the JSON serialization of an object a chunk at a time as the stream is read. The
+ * object graph is walked with an explicit stack so generation can pause between values
+ */
+@interface RKJSONGeneratorStream : NSInputStream {
+	id _object;
+	RKJSONGenerator* _generator;
+	NSMutableArray* _containerStack;
+	NSMutableArray* _enumeratorStack;
+	NSUInteger _bufferOffset;
+	BOOL _hasStarted;
+	BOOL _isGenerated;
+
+	@private
+	NSStreamStatus _streamStatus;
+}
+
+- (id)initWithObject:(id)object;
+
+@end
+
+@implementation RKJSONGeneratorStream
+
+- (id)initWithObject:(id)object {
+	if ((self = [super init])) {
+		_object = [object retain];
+		_generator = [[RKJSONGenerator alloc] initWithGenOptions:YAJLGenOptionsIncludeUnsupportedTypes indentString:@""];
+		_containerStack = [[NSMutableArray alloc] init];
+		_enumeratorStack = [[NSMutableArray alloc] init];
+	}
+
+	return self;
+}
+
+- (void)dealloc {
+	[_object release];
+	[_generator release];
+	[_containerStack release];
+	[_enumeratorStack release];
+	[super dealloc];
+}
+
+// Containers are opened and pushed onto the stack; everything else is generated by YAJLGen
+- (void)generateObject:(id)object {
+	while ([object respondsToSelector:@selector(JSON)]) {
+		object = [object JSON];
+	}
+
+	if ([object isKindOfClass:[NSArray class]]) {
+		[_generator startArray];
+		[_containerStack addObject:object];
+		[_enumeratorStack addObject:[object objectEnumerator]];
+	} else if ([object isKindOfClass:[NSDictionary class]]) {
+		[_generator startDictionary];
+		[_containerStack addObject:object];
+		[_enumeratorStack addObject:[object keyEnumerator]];
+	} else {
+		[_generator object:object];
+	}
+}
+
+- (void)generateNextValue {
+	if (NO == _hasStarted) {
+		_hasStarted = YES;
+		[self generateObject:_object];
+	} else if ([_containerStack count] == 0) {
+		_isGenerated = YES;
+	} else {
+		id container = [_containerStack lastObject];
+		id next = [[_enumeratorStack lastObject] nextObject];
+		if (nil == next) {
+			if ([container isKindOfClass:[NSArray class]]) {
+				[_generator endArray];
+			} else {
+				[_generator endDictionary];
+			}
+			[_containerStack removeLastObject];
+			[_enumeratorStack removeLastObject];
+		} else if ([container isKindOfClass:[NSDictionary class]]) {
+			[_generator object:next];
+			[self generateObject:[container objectForKey:next]];
+		} else {
+			[self generateObject:next];
+		}
+	}
+}
+
+#pragma mark NSInputStream methods
+
+- (NSInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)maxLength {
+	NSUInteger bytesRead = 0;
+	const unsigned char* generatedBytes;
+	unsigned int generatedLength;
+
+	_streamStatus = NSStreamStatusReading;
+	while (bytesRead < maxLength) {
+		[_generator getBuffer:&generatedBytes length:&generatedLength];
+		if (_bufferOffset < generatedLength) {
+			NSUInteger length = MIN(generatedLength - _bufferOffset, maxLength - bytesRead);
+			memcpy(buffer + bytesRead, generatedBytes + _bufferOffset, length);
+			_bufferOffset += length;
+			bytesRead += length;
+			continue;
+		}
+		if (_isGenerated) {
+			break;
+		}
+
+		// The reader has consumed the buffer, so generate the next chunk into it
+		[_generator clear];
+		_bufferOffset = 0;
+		generatedLength = 0;
+		@try {
+			while (NO == _isGenerated && generatedLength < kRKJSONGeneratorStreamChunkSize) {
+				[self generateNextValue];
+				[_generator getBuffer:&generatedBytes length:&generatedLength];
+			}
+		} @catch (NSException* exception) {
+			NSLog(@"[RestKit] RKJSONGeneratorStream: Failed to generate JSON: %@", exception);
+			_streamStatus = NSStreamStatusError;
+			return -1;
+		}
+	}
+
+	return bytesRead;
+}
+
+- (BOOL)getBuffer:(uint8_t **)buffer length:(NSUInteger *)len {
+	return NO;
+}
+
+- (BOOL)hasBytesAvailable {
+	const unsigned char* generatedBytes;
+	unsigned int generatedLength;
+	[_generator getBuffer:&generatedBytes length:&generatedLength];
+	return (NO == _isGenerated || _bufferOffset < generatedLength);
+}
+
+- (void)open {
+	_streamStatus = NSStreamStatusOpen;
+}
+
+- (void)close {
+	_streamStatus = NSStreamStatusClosed;
+}
+
+- (NSStreamStatus)streamStatus {
+	if (_streamStatus != NSStreamStatusClosed && _streamStatus != NSStreamStatusError && NO == [self hasBytesAvailable]) {
+		_streamStatus = NSStreamStatusAtEnd;
+	}
+
+	return _streamStatus;
+}
+
+#pragma mark Core Foundation stream methods
+
+- (void)_scheduleInCFRunLoop:(NSRunLoop *)runLoop forMode:(id)mode {
+}
+
+- (void)_setCFClientFlags:(CFOptionFlags)flags callback:(CFReadStreamClientCallBack)callback context:(CFStreamClientContext)context {
+}
+
+@end
+
 @implementation RKJSONParser
 
 - (NSDictionary*)objectFromString:(NSString*)string {
@@ -20,8 +375,25 @@
 	return json;
 }
 
+- (id)objectFromData:(NSData*)data {
+	NSError* error = nil;
+	id json = [data rk_yajl_JSON:&error];
+	if (error) {
+		NSLog(@"Encountered error: %@ parsing json data of length %lu", error, (unsigned long)[data length]);
+	}
+	return json;
+}
+
 - (NSString*)stringFromObject:(id)object {
 	return [object rk_yajl_JSONString];
 }
 
+- (NSObject<RKStreamingParser>*)streamingParserWithKeyPath:(NSString*)keyPath delegate:(NSObject<RKStreamingParserDelegate>*)delegate {
+	return [[[RKJSONStreamingParser alloc] initWithKeyPath:keyPath delegate:delegate] autorelease];
+}
+
+- (NSInputStream*)inputStreamWithObject:(id)object {
+	return [[[RKJSONGeneratorStream alloc] initWithObject:object] autorelease];
+}
+
 @end
@@ -0,0 +1,40 @@
+//
+//  RKDateParser.h
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * Parses an ISO-8601 timestamp such as 2009-08-17T19:24:40Z without going through
+ * NSDateFormatter. The date and time may be separated by a T or a space, the seconds
+ * may carry a fractional part, and the timestamp may end in a +hh:mm, +hhmm or +hh offset.
+ *
+ * Timestamps without a numeric offset, including those ending in a Z designator, are
+ * interpreted in timeZone. Pass a UTC time zone for strict handling of the Z designator.
+ *
+ * Returns NO if string is not a complete timestamp.
+ */
+BOOL RKDateParserParseISO8601(const char* string, NSTimeZone* timeZone, NSTimeInterval* timeIntervalSince1970);
+
+/**
+ * Parses a .NET JSON date such as /Date(1297468800000)/ or /Date(1297468800000-0500)/.
+ * The ticks are milliseconds since 1970 in UTC; the optional offset only describes the time
+ * zone of the originating system and does not change the instant.
+ *
+ * Returns NO if string is not a .NET JSON date.
+ */
+BOOL RKDateParserParseDotNet(const char* string, NSTimeInterval* timeIntervalSince1970);
+
+/**
+ * Returns the date for an ISO-8601 timestamp, or nil. See RKDateParserParseISO8601
+ */
+NSDate* RKDateFromISO8601String(NSString* string, NSTimeZone* timeZone);
+
+/**
+ * Returns the date for a .NET JSON date, or nil. See RKDateParserParseDotNet
+ */
+NSDate* RKDateFromDotNetString(NSString* string);
@@ -0,0 +1,227 @@
+//
+//  RKDateParser.m
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import "RKDateParser.h"
+
+// Large enough for any timestamp either parser accepts
+#define RKDateParserMaxLength 64
+
+static BOOL RKDateParserReadDigits(const char** cursor, int count, int* value) {
+	int result = 0;
+	int i;
+	for (i = 0; i < count; i++) {
+		char c = (*cursor)[i];
+		if (c < '0' || c > '9') {
+			return NO;
+		}
+		result = result * 10 + (c - '0');
+	}
+
+	*cursor += count;
+	*value = result;
+	return YES;
+}
+
+static BOOL RKDateParserIsLeapYear(int year) {
+	return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static int RKDateParserDaysInMonth(int year, int month) {
+	static const int daysInMonth[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+	return (month == 2 && RKDateParserIsLeapYear(year)) ? 29 : daysInMonth[month - 1];
+}
+
+// Days between 1970-01-01 and the given proleptic Gregorian date
+static long long RKDateParserDaysSince1970(int year, int month, int day) {
+	long long y = year - (month <= 2 ? 1 : 0);
+	long long era = (y >= 0 ? y : y - 399) / 400;
+	long long yearOfEra = y - era * 400;
+	long long dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+	long long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+	return era * 146097 + dayOfEra - 719468;
+}
+
+// Converts a wall clock time, expressed as seconds since 1970 as if it were UTC, to an
+// instant in timeZone. The offset is looked up a second time for times near a DST transition
+static NSTimeInterval RKDateParserTimeIntervalInTimeZone(NSTimeInterval wallClockTime, NSTimeZone* timeZone) {
+	if (nil == timeZone) {
+		return wallClockTime;
+	}
+
+	CFTimeZoneRef zone = (CFTimeZoneRef)timeZone;
+	NSTimeInterval offset = CFTimeZoneGetSecondsFromGMT(zone, wallClockTime - kCFAbsoluteTimeIntervalSince1970);
+	NSTimeInterval timeInterval = wallClockTime - offset;
+	NSTimeInterval adjustedOffset = CFTimeZoneGetSecondsFromGMT(zone, timeInterval - kCFAbsoluteTimeIntervalSince1970);
+	if (adjustedOffset != offset) {
+		timeInterval = wallClockTime - adjustedOffset;
+	}
+
+	return timeInterval;
+}
+
+BOOL RKDateParserParseISO8601(const char* string, NSTimeZone* timeZone, NSTimeInterval* timeIntervalSince1970) {
+	if (NULL == string) {
+		return NO;
+	}
+
+	const char* cursor = string;
+	int year, month, day, hour, minute, second;
+	if (!RKDateParserReadDigits(&cursor, 4, &year) || *cursor++ != '-' ||
+		!RKDateParserReadDigits(&cursor, 2, &month) || *cursor++ != '-' ||
+		!RKDateParserReadDigits(&cursor, 2, &day)) {
+		return NO;
+	}
+	if (*cursor != 'T' && *cursor != ' ') {
+		return NO;
+	}
+	cursor++;
+	if (!RKDateParserReadDigits(&cursor, 2, &hour) || *cursor++ != ':' ||
+		!RKDateParserReadDigits(&cursor, 2, &minute) || *cursor++ != ':' ||
+		!RKDateParserReadDigits(&cursor, 2, &second)) {
+		return NO;
+	}
+	if (month < 1 || month > 12 || day < 1 || day > RKDateParserDaysInMonth(year, month) ||
+		hour > 23 || minute > 59 || second > 60) {
+		return NO;
+	}
+
+	double fraction = 0;
+	if (*cursor == '.' || *cursor == ',') {
+		cursor++;
+		double scale = 0.1;
+		if (*cursor < '0' || *cursor > '9') {
+			return NO;
+		}
+		while (*cursor >= '0' && *cursor <= '9') {
+			fraction += (*cursor - '0') * scale;
+			scale /= 10;
+			cursor++;
+		}
+	}
+
+	BOOL hasOffset = NO;
+	int offset = 0;
+	if (*cursor == 'Z') {
+		cursor++;
+	} else if (*cursor == '+' || *cursor == '-') {
+		int sign = (*cursor == '-') ? -1 : 1;
+		int offsetHours, offsetMinutes = 0;
+		cursor++;
+		if (!RKDateParserReadDigits(&cursor, 2, &offsetHours)) {
+			return NO;
+		}
+		if (*cursor == ':') {
+			cursor++;
+			if (!RKDateParserReadDigits(&cursor, 2, &offsetMinutes)) {
+				return NO;
+			}
+		} else if (*cursor != '\0' && !RKDateParserReadDigits(&cursor, 2, &offsetMinutes)) {
+			return NO;
+		}
+		if (offsetHours > 23 || offsetMinutes > 59) {
+			return NO;
+		}
+		hasOffset = YES;
+		offset = sign * (offsetHours * 3600 + offsetMinutes * 60);
+	}
+	if (*cursor != '\0') {
+		return NO;
+	}
+
+	NSTimeInterval wallClockTime = (NSTimeInterval)RKDateParserDaysSince1970(year, month, day) * 86400 + hour * 3600 + minute * 60 + second + fraction;
+	if (hasOffset) {
+		*timeIntervalSince1970 = wallClockTime - offset;
+	} else {
+		*timeIntervalSince1970 = RKDateParserTimeIntervalInTimeZone(wallClockTime, timeZone);
+	}
+
+	return YES;
+}
+
+BOOL RKDateParserParseDotNet(const char* string, NSTimeInterval* timeIntervalSince1970) {
+	if (NULL == string) {
+		return NO;
+	}
+
+	const char* cursor = string;
+	BOOL hasLeadingSlash = (*cursor == '/');
+	if (hasLeadingSlash) {
+		cursor++;
+	}
+	if (strncmp(cursor, "Date(", 5) != 0) {
+		return NO;
+	}
+	cursor += 5;
+
+	long long sign = 1;
+	if (*cursor == '-') {
+		sign = -1;
+		cursor++;
+	}
+	long long milliseconds = 0;
+	int digits = 0;
+	while (*cursor >= '0' && *cursor <= '9') {
+		if (++digits > 18) {
+			return NO;
+		}
+		milliseconds = milliseconds * 10 + (*cursor - '0');
+		cursor++;
+	}
+	if (digits == 0) {
+		return NO;
+	}
+
+	// The offset describes the originating time zone only; the ticks are already UTC
+	if (*cursor == '+' || *cursor == '-') {
+		int offset;
+		cursor++;
+		if (!RKDateParserReadDigits(&cursor, 4, &offset)) {
+			return NO;
+		}
+	}
+	if (*cursor++ != ')') {
+		return NO;
+	}
+	if (hasLeadingSlash && *cursor++ != '/') {
+		return NO;
+	}
+	if (*cursor != '\0') {
+		return NO;
+	}
+
+	*timeIntervalSince1970 = (NSTimeInterval)(sign * milliseconds) / 1000.0;
+	return YES;
+}
+
+static BOOL RKDateParserGetCString(NSString* string, char* buffer) {
+	if (![string isKindOfClass:[NSString class]]) {
+		return NO;
+	}
+
+	return [string getCString:buffer maxLength:RKDateParserMaxLength encoding:NSASCIIStringEncoding];
+}
+
+NSDate* RKDateFromISO8601String(NSString* string, NSTimeZone* timeZone) {
+	char buffer[RKDateParserMaxLength];
+	NSTimeInterval timeInterval;
+	if (RKDateParserGetCString(string, buffer) && RKDateParserParseISO8601(buffer, timeZone, &timeInterval)) {
+		return [NSDate dateWithTimeIntervalSince1970:timeInterval];
+	}
+
+	return nil;
+}
+
+NSDate* RKDateFromDotNetString(NSString* string) {
+	char buffer[RKDateParserMaxLength];
+	NSTimeInterval timeInterval;
+	if (RKDateParserGetCString(string, buffer) && RKDateParserParseDotNet(buffer, &timeInterval)) {
+		return [NSDate dateWithTimeIntervalSince1970:timeInterval];
+	}
+
+	return nil;
+}
@@ -0,0 +1,25 @@
+//
+//  RKDigest.h
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * Returns the lowercase hexadecimal representation of length bytes, as used
+ * for digests that end up in file names and keys
+ */
+NSString* RKHexStringFromBytes(const unsigned char* bytes, NSUInteger length);
+
+/**
+ * Returns the hexadecimal MD5 digest of the UTF-8 encoding of string
+ */
+NSString* RKMD5HexDigestOfString(NSString* string);
+
+/**
+ * Returns the hexadecimal SHA-1 digest of the UTF-8 encoding of string
+ */
+NSString* RKSHA1HexDigestOfString(NSString* string);
@@ -0,0 +1,36 @@
+//
+//  RKDigest.m
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import <CommonCrypto/CommonDigest.h>
+#import "RKDigest.h"
+
+NSString* RKHexStringFromBytes(const unsigned char* bytes, NSUInteger length) {
+	NSMutableString* hex = [NSMutableString stringWithCapacity:length * 2];
+	NSUInteger i;
+	for (i = 0; i < length; i++) {
+		[hex appendFormat:@"%02x", bytes[i]];
+	}
+
+	return hex;
+}
+
+NSString* RKMD5HexDigestOfString(NSString* string) {
+	NSData* data = [string dataUsingEncoding:NSUTF8StringEncoding];
+	unsigned char digest[CC_MD5_DIGEST_LENGTH];
+	CC_MD5([data bytes], (CC_LONG)[data length], digest);
+
+	return RKHexStringFromBytes(digest, CC_MD5_DIGEST_LENGTH);
+}
+
+NSString* RKSHA1HexDigestOfString(NSString* string) {
+	NSData* data = [string dataUsingEncoding:NSUTF8StringEncoding];
+	unsigned char digest[CC_SHA1_DIGEST_LENGTH];
+	CC_SHA1([data bytes], (CC_LONG)[data length], digest);
+
+	return RKHexStringFromBytes(digest, CC_SHA1_DIGEST_LENGTH);
+}
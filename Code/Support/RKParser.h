@@ -6,6 +6,9 @@
 //  Copyright 2010 Two Toasters. All rights reserved.
 //
 
+@protocol RKStreamingParser;
+@protocol RKStreamingParserDelegate;
+
 /**
  * A Parser is responsible for transforming a string
  * of data into a dictionary. This allows the model mapper to
@@ -22,4 +25,88 @@
 
 - (NSString*)stringFromObject:(id)object;
 
+@optional
+
+/**
+ * Return a key-value coding compliant representation of a UTF-8 encoded payload.
+ * Prefer this over objectFromString: when the payload is already available as bytes,
+ * as it avoids transcoding the payload into a string and back. Parsers that do not
+ * implement it are handed the payload decoded into a string.
+ */
+- (id)objectFromData:(NSData*)data;
+
+/**
+ * Returns a new autoreleased streaming parser that hands each element of the collection
+ * found at keyPath to the delegate as soon as it has been parsed. When keyPath is nil,
+ * the elements of a top level collection are streamed. When delegate is nil, nothing is
+ * streamed and the parser incrementally assembles the complete payload into its result.
+ *
+ * Parsers that can only build complete object graphs do not implement this method.
+ */
+- (NSObject<RKStreamingParser>*)streamingParserWithKeyPath:(NSString*)keyPath delegate:(NSObject<RKStreamingParserDelegate>*)delegate;
+
+/**
+ * Returns a new autoreleased, unopened input stream producing the same serialization as
+ * stringFromObject:. The serialization is generated a chunk at a time as the stream is read,
+ * so it is never held in memory as a whole. The object must not be mutated while the stream
+ * is being read.
+ *
+ * Parsers that can only generate complete strings do not implement this method.
+ */
+- (NSInputStream*)inputStreamWithObject:(id)object;
+
+@end
+
+/**
+ * A parser fed a payload one chunk at a time. Elements of the streamed collection
+ * are never retained by the parser; everything else in the payload is assembled
+ * into the result.
+ */
+@protocol RKStreamingParser
+
+/**
+ * The key path of the collection whose elements are streamed to the delegate
+ */
+@property (nonatomic, readonly) NSString* keyPath;
+
+/**
+ * The object the parsed elements are handed to
+ */
+@property (nonatomic, assign) NSObject<RKStreamingParserDelegate>* delegate;
+
+/**
+ * YES once the collection at keyPath has been encountered in the payload
+ */
+@property (nonatomic, readonly) BOOL isStreaming;
+
+/**
+ * The payload parsed so far, with the streamed collection left empty
+ */
+@property (nonatomic, readonly) id result;
+
+/**
+ * The error encountered while parsing, if any
+ */
+@property (nonatomic, readonly) NSError* error;
+
+/**
+ * Parses the next chunk of the payload. Returns NO if the payload is malformed
+ */
+- (BOOL)parseData:(NSData*)data;
+
+/**
+ * Signals that the entire payload has been supplied. Returns NO if the payload
+ * was incomplete or malformed
+ */
+- (BOOL)finishParsing;
+
+@end
+
+@protocol RKStreamingParserDelegate
+
+/**
+ * Sent for each element of the streamed collection as soon as it has been completely parsed
+ */
+- (void)parser:(NSObject<RKStreamingParser>*)parser didParseObject:(id)object;
+
 @end
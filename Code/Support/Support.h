@@ -8,3 +8,5 @@
 
 #import "Errors.h"
 #import "NSDictionary+RKAdditions.h"
+#import "RKDateParser.h"
+#import "RKDigest.h"
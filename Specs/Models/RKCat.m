@@ -24,4 +24,21 @@
 
 @dynamic human;
 
++ (NSDictionary*)elementToPropertyMappings {
+	return [NSDictionary dictionaryWithObjectsAndKeys:
+			@"railsID", @"id",
+			@"name", @"name",
+			nil];
+}
+
++ (NSDictionary*)elementToRelationshipMappings {
+	return [NSDictionary dictionaryWithObjectsAndKeys:
+			@"human", @"human",
+			nil];
+}
+
++ (NSString*)primaryKeyProperty {
+	return @"railsID";
+}
+
 @end
@@ -12,11 +12,17 @@
 	NSString* _name;
 	NSNumber* _age;
 	NSDate* _createdAt;
+	NSInteger _luckyNumber;
+	double _rating;
+	BOOL _active;
 }
 
 @property (nonatomic,retain) NSString* name;
 @property (nonatomic,retain) NSNumber* age;
 @property (nonatomic,retain) NSDate* createdAt;
+@property (nonatomic,assign) NSInteger luckyNumber;
+@property (nonatomic,assign) double rating;
+@property (nonatomic,assign,getter=isActive) BOOL active;
 
 @end
 
@@ -13,5 +13,8 @@
 @synthesize name = _name;
 @synthesize age = _age;
 @synthesize createdAt = _createdAt;
+@synthesize luckyNumber = _luckyNumber;
+@synthesize rating = _rating;
+@synthesize active = _active;
 
 @end
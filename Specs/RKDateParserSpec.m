@@ -0,0 +1,51 @@
+//
+//  RKDateParserSpec.m
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import "RKSpecEnvironment.h"
+#import "RKDateParser.h"
+
+@interface RKDateParserSpec : NSObject <UISpec>
+
+@end
+
+@implementation RKDateParserSpec
+
+- (void)itShouldParseRailsTimestamps {
+	NSTimeZone* UTC = [NSTimeZone timeZoneForSecondsFromGMT:0];
+	NSDate* date = RKDateFromISO8601String(@"2009-08-17T19:24:40Z", UTC);
+	[expectThat([date timeIntervalSince1970]) should:be(1250537080)];
+}
+
+- (void)itShouldParseFractionalSecondsAndOffsets {
+	NSTimeZone* UTC = [NSTimeZone timeZoneForSecondsFromGMT:0];
+	NSDate* date = RKDateFromISO8601String(@"2009-08-17T14:24:40.5-05:00", UTC);
+	[expectThat([date timeIntervalSince1970]) should:be(1250537080.5)];
+	date = RKDateFromISO8601String(@"2009-08-17 21:24:40+0200", UTC);
+	[expectThat([date timeIntervalSince1970]) should:be(1250537080)];
+}
+
+- (void)itShouldInterpretTimestampsWithoutAnOffsetInTheGivenTimeZone {
+	NSTimeZone* timeZone = [NSTimeZone timeZoneForSecondsFromGMT:3600];
+	NSDate* date = RKDateFromISO8601String(@"2009-08-17T20:24:40", timeZone);
+	[expectThat([date timeIntervalSince1970]) should:be(1250537080)];
+}
+
+- (void)itShouldRejectMalformedTimestamps {
+	NSTimeZone* UTC = [NSTimeZone timeZoneForSecondsFromGMT:0];
+	[expectThat(RKDateFromISO8601String(@"08/17/2009", UTC)) should:be(nil)];
+	[expectThat(RKDateFromISO8601String(@"2009-02-30T00:00:00Z", UTC)) should:be(nil)];
+	[expectThat(RKDateFromISO8601String(@"2009-08-17T19:24:40Zjunk", UTC)) should:be(nil)];
+}
+
+- (void)itShouldParseDotNetDates {
+	[expectThat([RKDateFromDotNetString(@"/Date(1250537080000)/") timeIntervalSince1970]) should:be(1250537080)];
+	[expectThat([RKDateFromDotNetString(@"/Date(1250537080000-0500)/") timeIntervalSince1970]) should:be(1250537080)];
+	[expectThat(RKDateFromDotNetString(@"/Date(abc)/")) should:be(nil)];
+}
+
+@end
@@ -0,0 +1,86 @@
+//
+//  RKManagedObjectIdentityMapSpec.m
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import "RKSpecEnvironment.h"
+#import "RKManagedObjectIdentityMap.h"
+
+@interface RKManagedObjectIdentityMapSpec : NSObject <UISpec>
+
+- (NSManagedObjectID*)objectID;
+
+@end
+
+@implementation RKManagedObjectIdentityMapSpec
+
+- (void)itShouldCountHitsAndMisses {
+	RKManagedObjectIdentityMap* identityMap = [[[RKManagedObjectIdentityMap alloc] initWithCapacity:10] autorelease];
+	NSManagedObjectID* objectID = [self objectID];
+	[identityMap setObjectID:objectID forPrimaryKeyValue:[NSNumber numberWithInt:1]];
+
+	[expectThat([identityMap objectIDForPrimaryKeyValue:[NSNumber numberWithInt:1]] == objectID) should:be(YES)];
+	[expectThat([identityMap objectIDForPrimaryKeyValue:[NSNumber numberWithInt:2]]) should:be(nil)];
+	[expectThat(identityMap.hits) should:be(1)];
+	[expectThat(identityMap.misses) should:be(1)];
+
+	[identityMap removeAllObjectIDs];
+	[expectThat(identityMap.count) should:be(0)];
+	[expectThat(identityMap.hits) should:be(1)];
+}
+
+- (void)itShouldIgnoreTemporaryObjectIDs {
+	RKManagedObjectIdentityMap* identityMap = [[[RKManagedObjectIdentityMap alloc] initWithCapacity:10] autorelease];
+	id objectID = [OCMockObject niceMockForClass:[NSManagedObjectID class]];
+	BOOL isTemporaryID = YES;
+	[[[objectID stub] andReturnValue:OCMOCK_VALUE(isTemporaryID)] isTemporaryID];
+	[identityMap setObjectID:objectID forPrimaryKeyValue:[NSNumber numberWithInt:1]];
+	[expectThat(identityMap.count) should:be(0)];
+}
+
+- (void)itShouldEvictTheFirstEntryNotReferencedSinceTheLastSweepWhenFull {
+	RKManagedObjectIdentityMap* identityMap = [[[RKManagedObjectIdentityMap alloc] initWithCapacity:3] autorelease];
+	NSNumber* one = [NSNumber numberWithInt:1];
+	NSNumber* two = [NSNumber numberWithInt:2];
+	NSNumber* three = [NSNumber numberWithInt:3];
+	NSNumber* four = [NSNumber numberWithInt:4];
+	NSNumber* five = [NSNumber numberWithInt:5];
+	[identityMap setObjectID:[self objectID] forPrimaryKeyValue:one];
+	[identityMap setObjectID:[self objectID] forPrimaryKeyValue:two];
+	[identityMap setObjectID:[self objectID] forPrimaryKeyValue:three];
+	[expectThat(identityMap.count) should:be(3)];
+
+	// Every entry is referenced, so the hand sweeps a full turn clearing marks and evicts the oldest
+	[identityMap setObjectID:[self objectID] forPrimaryKeyValue:four];
+	[expectThat(identityMap.count) should:be(3)];
+	[expectThat(identityMap.evictions) should:be(1)];
+	[expectThat([identityMap objectIDForPrimaryKeyValue:one]) should:be(nil)];
+
+	// 2 is used again and so survives the next sweep, unlike 3
+	[identityMap objectIDForPrimaryKeyValue:two];
+	[identityMap setObjectID:[self objectID] forPrimaryKeyValue:five];
+	[expectThat(identityMap.evictions) should:be(2)];
+	[expectThat([identityMap objectIDForPrimaryKeyValue:two]) shouldNot:be(nil)];
+	[expectThat([identityMap objectIDForPrimaryKeyValue:three]) should:be(nil)];
+	[expectThat([identityMap objectIDForPrimaryKeyValue:four]) shouldNot:be(nil)];
+	[expectThat([identityMap objectIDForPrimaryKeyValue:five]) shouldNot:be(nil)];
+}
+
+- (void)itShouldReplaceTheObjectIDOfAKeyWithoutEvicting {
+	RKManagedObjectIdentityMap* identityMap = [[[RKManagedObjectIdentityMap alloc] initWithCapacity:1] autorelease];
+	NSManagedObjectID* objectID = [self objectID];
+	[identityMap setObjectID:[self objectID] forPrimaryKeyValue:@"key"];
+	[identityMap setObjectID:objectID forPrimaryKeyValue:@"key"];
+	[expectThat(identityMap.evictions) should:be(0)];
+	[expectThat([identityMap objectIDForPrimaryKeyValue:@"key"] == objectID) should:be(YES)];
+}
+
+// A permanent object ID: nice mocks answer NO to isTemporaryID
+- (NSManagedObjectID*)objectID {
+	return [OCMockObject niceMockForClass:[NSManagedObjectID class]];
+}
+
+@end
@@ -9,13 +9,196 @@
 #import "RKSpecEnvironment.h"
 #import "RKObjectManager.h"
 #import "RKHuman.h"
+#import "RKCat.h"
+
+@interface RKManagedObjectStore (SpecPrivate)
+
+- (NSMutableDictionary*)pendingObjectsForManagedObject:(Class)class;
+
+@end
 
 @interface RKManagedObjectSpec : NSObject <UISpec> {
-	
+	RKObjectManager* _previousSharedManager;
+	RKObjectManager* _objectManager;
+	RKManagedObjectStore* _store;
+	BOOL _backgroundMappingFinished;
 }
 
+- (void)mapCatsInBackground:(NSArray*)mapperAndElements;
+- (void)deleteAllObjects;
+- (void)createHumansWithRailsIDsUpTo:(NSInteger)count;
+
 @end
 
 @implementation RKManagedObjectSpec
 
+- (void)beforeAll {
+	_previousSharedManager = [[RKObjectManager sharedManager] retain];
+	_store = [[RKManagedObjectStore alloc] initWithStoreFilename:@"RKManagedObjectSpecs.sqlite"];
+	_objectManager = [[RKObjectManager alloc] initWithBaseURL:@"http://localhost:4567"];
+	_objectManager.objectStore = _store;
+	[RKObjectManager setSharedManager:_objectManager];
+}
+
+- (void)afterAll {
+	[RKObjectManager setSharedManager:_previousSharedManager];
+	[_previousSharedManager release];
+	[_objectManager release];
+	[_store release];
+}
+
+- (void)before {
+	[self deleteAllObjects];
+}
+
+- (void)itShouldFindInstancesAcrossSeveralBatchesOfPrimaryKeys {
+	[self createHumansWithRailsIDsUpTo:1200];
+	[[_store identityMapForManagedObject:[RKHuman class]] removeAllObjectIDs];
+
+	NSMutableArray* primaryKeyValues = [NSMutableArray array];
+	NSInteger i;
+	for (i = 1; i <= 1200; i++) {
+		[primaryKeyValues addObject:[NSNumber numberWithInteger:i]];
+	}
+	NSDictionary* humans = [_store findInstancesOfManagedObject:[RKHuman class] withPrimaryKeyValues:primaryKeyValues];
+	[expectThat([humans count]) should:be(1200)];
+	[expectThat([[humans objectForKey:[NSNumber numberWithInt:1]] railsID]) should:be(1)];
+	[expectThat([[humans objectForKey:[NSNumber numberWithInt:501]] railsID]) should:be(501)];
+	[expectThat([[humans objectForKey:[NSNumber numberWithInt:1200]] railsID]) should:be(1200)];
+
+	// Every object found by the fetch is now resolved through the identity map
+	[expectThat([[_store identityMapForManagedObject:[RKHuman class]] count]) should:be(1200)];
+}
+
+- (void)itShouldCoercePrimaryKeyValuesToTheTypeOfThePrimaryKeyAttribute {
+	[self createHumansWithRailsIDsUpTo:3];
+	[[_store identityMapForManagedObject:[RKHuman class]] removeAllObjectIDs];
+
+	NSArray* primaryKeyValues = [NSArray arrayWithObjects:@"1", @"2", [NSNumber numberWithInt:3], nil];
+	NSDictionary* humans = [_store findInstancesOfManagedObject:[RKHuman class] withPrimaryKeyValues:primaryKeyValues];
+	[expectThat([humans count]) should:be(3)];
+	[expectThat([[humans objectForKey:[NSNumber numberWithInt:1]] railsID]) should:be(1)];
+	[expectThat([humans objectForKey:@"1"]) should:be(nil)];
+
+	RKHuman* human = (RKHuman*)[_store findOrCreateInstanceOfManagedObject:[RKHuman class] withPrimaryKeyValue:@"2"];
+	[expectThat(human == [humans objectForKey:[NSNumber numberWithInt:2]]) should:be(YES)];
+}
+
+- (void)itShouldRememberPrimaryKeysThatDoNotExistUntilTheyAreInserted {
+	[self createHumansWithRailsIDsUpTo:1];
+	NSArray* primaryKeyValues = [NSArray arrayWithObjects:[NSNumber numberWithInt:1], @"5000", nil];
+	NSDictionary* humans = [_store findInstancesOfManagedObject:[RKHuman class] withPrimaryKeyValues:primaryKeyValues];
+	[expectThat([humans count]) should:be(1)];
+
+	NSMutableDictionary* pendingHumans = [_store pendingObjectsForManagedObject:[RKHuman class]];
+	[expectThat([pendingHumans objectForKey:[NSNumber numberWithInt:5000]]) should:be([NSNull null])];
+
+	// Inserting the missing object replaces the negative entry so the next lookup finds it without a fetch
+	RKHuman* human = [RKHuman object];
+	human.railsID = [NSNumber numberWithInt:5000];
+	[[_store managedObjectContext] processPendingChanges];
+	humans = [_store findInstancesOfManagedObject:[RKHuman class] withPrimaryKeyValues:[NSArray arrayWithObject:@"5000"]];
+	[expectThat([humans objectForKey:[NSNumber numberWithInt:5000]] == human) should:be(YES)];
+
+	// Saving clears the pending objects of the thread
+	[_store save];
+	[expectThat([[_store pendingObjectsForManagedObject:[RKHuman class]] count]) should:be(0)];
+}
+
+- (void)itShouldForgetTheObjectIDsOfDeletedObjects {
+	[self createHumansWithRailsIDsUpTo:1];
+	RKManagedObjectIdentityMap* identityMap = [_store identityMapForManagedObject:[RKHuman class]];
+	[expectThat([identityMap objectIDForPrimaryKeyValue:[NSNumber numberWithInt:1]]) shouldNot:be(nil)];
+
+	NSManagedObjectContext* context = [_store managedObjectContext];
+	[context deleteObject:[RKHuman objectWithPrimaryKeyValue:[NSNumber numberWithInt:1]]];
+	[context processPendingChanges];
+	[expectThat([identityMap objectIDForPrimaryKeyValue:[NSNumber numberWithInt:1]]) should:be(nil)];
+}
+
+- (void)itShouldNotReturnObjectsDeletedByAnotherContext {
+	[self createHumansWithRailsIDsUpTo:1];
+	RKManagedObjectIdentityMap* identityMap = [_store identityMapForManagedObject:[RKHuman class]];
+	NSManagedObjectID* objectID = [identityMap objectIDForPrimaryKeyValue:[NSNumber numberWithInt:1]];
+	[expectThat(objectID) shouldNot:be(nil)];
+
+	// A context the store does not know about, so the identity map still holds the object ID
+	NSManagedObjectContext* otherContext = [[NSManagedObjectContext alloc] init];
+	[otherContext setPersistentStoreCoordinator:_store.persistentStoreCoordinator];
+	[otherContext deleteObject:[otherContext objectWithID:objectID]];
+	[otherContext save:nil];
+	[otherContext release];
+	[[_store managedObjectContext] reset];
+	[expectThat([identityMap objectIDForPrimaryKeyValue:[NSNumber numberWithInt:1]]) shouldNot:be(nil)];
+
+	NSDictionary* humans = [_store findInstancesOfManagedObject:[RKHuman class] withPrimaryKeyValues:[NSArray arrayWithObject:[NSNumber numberWithInt:1]]];
+	[expectThat([humans count]) should:be(0)];
+	[expectThat([identityMap objectIDForPrimaryKeyValue:[NSNumber numberWithInt:1]]) should:be(nil)];
+}
+
+- (void)itShouldMapManagedObjectsSharingARelatedObjectSeriallyWhenParallelMappingIsEnabled {
+	RKObjectMapper* mapper = [[[RKObjectMapper alloc] init] autorelease];
+	mapper.parallelMappingEnabled = YES;
+	mapper.parallelMappingThreshold = 2;
+	[mapper registerClass:[RKHuman class] forElementNamed:@"human"];
+
+	NSDictionary* human = [NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithInt:1], @"id", @"Blake", @"name", nil];
+	NSMutableArray* elements = [NSMutableArray array];
+	int i;
+	for (i = 1; i <= 40; i++) {
+		[elements addObject:[NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithInt:i], @"id",
+							 [NSString stringWithFormat:@"Cat %d", i], @"name", human, @"human", nil]];
+	}
+
+	// Managed collections used to be split across threads only when mapped off the main thread
+	_backgroundMappingFinished = NO;
+	[NSThread detachNewThreadSelector:@selector(mapCatsInBackground:) toTarget:self withObject:[NSArray arrayWithObjects:mapper, elements, nil]];
+	NSDate* timeoutDate = [NSDate dateWithTimeIntervalSinceNow:10];
+	while (NO == _backgroundMappingFinished && [timeoutDate timeIntervalSinceNow] > 0) {
+		[[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+	}
+
+	[expectThat([RKCat count]) should:be(40)];
+	NSArray* humans = [RKHuman allObjects];
+	[expectThat([humans count]) should:be(1)];
+	for (RKCat* cat in [RKCat allObjects]) {
+		[expectThat(cat.human == [humans lastObject]) should:be(YES)];
+	}
+}
+
+- (void)mapCatsInBackground:(NSArray*)mapperAndElements {
+	NSAutoreleasePool* pool = [[NSAutoreleasePool alloc] init];
+	RKObjectMapper* mapper = [mapperAndElements objectAtIndex:0];
+	NSArray* cats = [mapper mapObjectsFromArrayOfDictionaries:[mapperAndElements objectAtIndex:1] toClass:[RKCat class]];
+	if ([cats count] == 40) {
+		[_store save];
+	}
+	[_store resetManagedObjectContext];
+	_backgroundMappingFinished = YES;
+	[pool drain];
+}
+
+- (void)deleteAllObjects {
+	NSManagedObjectContext* context = [_store managedObjectContext];
+	for (RKCat* cat in [RKCat allObjects]) {
+		[context deleteObject:cat];
+	}
+	for (RKHuman* human in [RKHuman allObjects]) {
+		[context deleteObject:human];
+	}
+	[_store save];
+	[[_store identityMapForManagedObject:[RKHuman class]] removeAllObjectIDs];
+	[[_store identityMapForManagedObject:[RKHuman class]] resetStatistics];
+}
+
+- (void)createHumansWithRailsIDsUpTo:(NSInteger)count {
+	NSInteger i;
+	for (i = 1; i <= count; i++) {
+		RKHuman* human = [RKHuman object];
+		human.railsID = [NSNumber numberWithInteger:i];
+		human.name = [NSString stringWithFormat:@"Human %d", i];
+	}
+	[_store save];
+}
+
 @end
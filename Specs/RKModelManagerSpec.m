@@ -78,4 +78,19 @@
 - (void)itShouldLoadHumansInPages {
 }
 
+- (void)itShouldPersistContentFingerprintsNextToTheStore {
+	RKManagedObjectStore* store = [[RKManagedObjectStore alloc] initWithStoreFilename:@"RKFingerprintSpecs.sqlite"];
+	[store setContentFingerprint:@"abc123" objectIDs:[NSArray array] forResourcePath:@"/humans"];
+	[store saveContentFingerprints];
+	[store release];
+
+	store = [[RKManagedObjectStore alloc] initWithStoreFilename:@"RKFingerprintSpecs.sqlite"];
+	[expectThat([store contentFingerprintForResourcePath:@"/humans"]) should:be(@"abc123")];
+	[expectThat([store objectIDsForContentFingerprint:@"abc123" resourcePath:@"/humans"] != nil) should:be(YES)];
+	[expectThat([store objectIDsForContentFingerprint:@"def456" resourcePath:@"/humans"]) should:be(nil)];
+	[store deletePersistantStore];
+	[expectThat([store contentFingerprintForResourcePath:@"/humans"]) should:be(nil)];
+	[store release];
+}
+
 @end
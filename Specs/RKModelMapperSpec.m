@@ -8,10 +8,21 @@
 
 #import "RKSpecEnvironment.h"
 #import "RKObjectMapper.h"
+#import "RKObjectMappingPlan.h"
 
 #import "RKMappableObject.h"
 #import "RKMappableAssociation.h"
 #import "RKObjectMapperSpecModel.h"
+#import "RKHuman.h"
+#import "RKCat.h"
+
+@interface RKObjectMapper (SpecPrivate)
+
+- (RKObjectMappingPlan*)mappingPlanForClass:(Class)class;
+- (BOOL)shouldMapInParallelArrayOfElements:(NSArray*)array toClass:(Class)class;
+- (NSDateFormatter*)dateFormatterForFormat:(NSString*)formatString;
+
+@end
 
 @interface RKObjectMapperSpec : NSObject <UISpec>
 
@@ -68,6 +79,44 @@
 	[expectThat([[result hasMany] count]) should:be(2)];
 }
 
+- (void)itShouldMapStreamedObjectsFromJSON {
+	RKObjectMapper* mapper = [[RKObjectMapper alloc] init];
+	mapper.format = RKMappingFormatJSON;
+	mapper.streamingEnabled = YES;
+	[mapper registerClass:[RKMappableObject class] forElementNamed:@"test_serialization_class"];
+	[mapper registerClass:[RKMappableAssociation class] forElementNamed:@"has_many"];
+	[mapper registerClass:[RKMappableAssociation class] forElementNamed:@"has_one"];
+	NSData* data = [[self jsonCollectionString] dataUsingEncoding:NSUTF8StringEncoding];
+	NSArray* results = [mapper mapFromData:data toClass:nil keyPath:nil];
+	[expectThat([results count]) should:be(2)];
+	
+	RKMappableObject* result = (RKMappableObject*) [results objectAtIndex:0];
+	[expectThat([result numberTest]) should:be(2)];
+	[expectThat([result stringTest]) should:be(@"SomeString")];
+	[expectThat([[result hasOne] testString]) should:be(@"A String")];
+	[expectThat([[result hasMany] count]) should:be(2)];
+}
+
+- (void)itShouldUpdateAnExistingObjectFromJSON {
+	RKObjectMapper* mapper = [[RKObjectMapper alloc] init];
+	mapper.format = RKMappingFormatJSON;
+	[mapper registerClass:[RKMappableObject class] forElementNamed:@"test_serialization_class"];
+	[mapper registerClass:[RKMappableAssociation class] forElementNamed:@"has_many"];
+	[mapper registerClass:[RKMappableAssociation class] forElementNamed:@"has_one"];
+	
+	RKMappableObject* object = [[[RKMappableObject alloc] init] autorelease];
+	object.stringTest = @"Stale";
+	object.numberTest = [NSNumber numberWithInt:2];
+	[mapper mapObject:object fromString:[self jsonString]];
+	[mapper mapObject:object fromString:[self jsonString]];
+	
+	[expectThat([object stringTest]) should:be(@"SomeString")];
+	[expectThat([object numberTest]) should:be(2)];
+	[expectThat([object dateTest]) shouldNot:be(nil)];
+	[expectThat([[object hasOne] testString]) should:be(@"A String")];
+	[expectThat([[object hasMany] count]) should:be(2)];
+}
+
 // TODO: re-implement these specs when we re-implement xml parsing.
 //- (void)itShouldMapFromXML {
 //	RKObjectMapper* mapper = [[RKObjectMapper alloc] init];
@@ -165,6 +214,117 @@
 	[expectThat(model.createdAt) should:be([NSDate dateWithTimeIntervalSince1970:0])];	
 }
 
+- (void)itShouldBeAbleToSetScalarPropertiesFromNumbers {
+	RKObjectMapperSpecModel* model = [[RKObjectMapperSpecModel alloc] autorelease];
+	RKObjectMapper* mapper = [[RKObjectMapper alloc] init];
+	
+	[mapper updateModel:model ifNewPropertyValue:[NSNumber numberWithInt:7] forPropertyNamed:@"luckyNumber"];
+	[mapper updateModel:model ifNewPropertyValue:[NSNumber numberWithDouble:4.5] forPropertyNamed:@"rating"];
+	[mapper updateModel:model ifNewPropertyValue:[NSNumber numberWithBool:YES] forPropertyNamed:@"active"];
+	[expectThat(model.luckyNumber) should:be(7)];
+	[expectThat(model.rating) should:be(4.5)];
+	[expectThat(model.isActive) should:be(YES)];
+}
+
+- (void)itShouldMapLargeCollectionsInParallelPreservingOrder {
+	RKObjectMapper* mapper = [[RKObjectMapper alloc] init];
+	mapper.parallelMappingEnabled = YES;
+	mapper.parallelMappingThreshold = 10;
+	NSMutableArray* elements = [NSMutableArray array];
+	int i;
+	for (i = 0; i < 1000; i++) {
+		[elements addObject:[NSDictionary dictionaryWithObject:[NSString stringWithFormat:@"%d", i] forKey:@"string_test"]];
+	}
+	
+	NSArray* results = [mapper mapObjectsFromArrayOfDictionaries:elements toClass:[RKMappableObject class]];
+	[expectThat([results count]) should:be(1000)];
+	[expectThat([[results objectAtIndex:0] stringTest]) should:be(@"0")];
+	[expectThat([[results objectAtIndex:617] stringTest]) should:be(@"617")];
+	[expectThat([[results lastObject] stringTest]) should:be(@"999")];
+	[mapper release];
+}
+
+- (void)itShouldOnlyMapCollectionsSeriallyWhenTheyCanReachManagedObjects {
+	if ([[NSProcessInfo processInfo] activeProcessorCount] < 2) {
+		return;
+	}
+	
+	RKObjectMapper* mapper = [[[RKObjectMapper alloc] init] autorelease];
+	mapper.parallelMappingEnabled = YES;
+	mapper.parallelMappingThreshold = 2;
+	[mapper registerClass:[RKHuman class] forElementNamed:@"human"];
+	[mapper registerClass:[RKMappableAssociation class] forElementNamed:@"has_one"];
+	NSDictionary* element = [NSDictionary dictionaryWithObject:@"Blake" forKey:@"name"];
+	NSArray* elements = [NSArray arrayWithObjects:element, element, nil];
+	
+	// A managed class registered for elements the collection never reaches does not matter
+	[expectThat([mapper shouldMapInParallelArrayOfElements:elements toClass:[RKMappableObject class]]) should:be(YES)];
+	[expectThat([mapper shouldMapInParallelArrayOfElements:elements toClass:[RKHuman class]]) should:be(NO)];
+	
+	NSArray* namedElements = [NSArray arrayWithObjects:[NSDictionary dictionaryWithObject:element forKey:@"human"],
+							  [NSDictionary dictionaryWithObject:element forKey:@"human"], nil];
+	[expectThat([mapper shouldMapInParallelArrayOfElements:namedElements toClass:nil]) should:be(NO)];
+	
+	// Managed objects reached through a relationship are mapped serially too
+	[mapper registerClass:[RKCat class] forElementNamed:@"has_one"];
+	[expectThat([mapper shouldMapInParallelArrayOfElements:elements toClass:[RKMappableObject class]]) should:be(NO)];
+}
+
+- (void)itShouldInspectTheAttributesOfProperties {
+	NSDictionary* attributesByName = [[RKObjectPropertyInspector sharedInspector] propertyAttributesForClass:[RKObjectMapperSpecModel class]];
+	RKObjectPropertyAttributes* active = [attributesByName objectForKey:@"active"];
+	[expectThat(NSStringFromSelector(active.getter)) should:be(@"isActive")];
+	[expectThat(NSStringFromSelector(active.setter)) should:be(@"setActive:")];
+	[expectThat(active.ivarName) should:be(@"_active")];
+	[expectThat(active.isObject) should:be(NO)];
+	
+	RKObjectPropertyAttributes* name = [attributesByName objectForKey:@"name"];
+	[expectThat(NSStringFromClass(name.propertyClass)) should:be(@"NSString")];
+	[expectThat(name.isObject) should:be(YES)];
+}
+
+- (void)itShouldMapMixedDateFormatsRememberingTheLastMatchedFormat {
+	RKObjectMapper* mapper = [[RKObjectMapper alloc] init];
+	NSArray* dateStrings = [NSArray arrayWithObjects:@"2009-08-17T19:24:40Z", @"08/17/2009", @"08/18/2009", @"/Date(1250537080000)/", nil];
+	NSMutableArray* elements = [NSMutableArray array];
+	for (NSString* dateString in dateStrings) {
+		[elements addObject:[NSDictionary dictionaryWithObject:dateString forKey:@"date_test"]];
+	}
+	
+	NSArray* results = [mapper mapObjectsFromArrayOfDictionaries:elements toClass:[RKMappableObject class]];
+	[expectThat([results count]) should:be(4)];
+	for (RKMappableObject* result in results) {
+		[expectThat([result dateTest]) shouldNot:be(nil)];
+	}
+	[expectThat([[[results objectAtIndex:2] dateTest] timeIntervalSinceDate:[[results objectAtIndex:1] dateTest]]) should:be(86400)];
+	[expectThat([[[results objectAtIndex:3] dateTest] timeIntervalSince1970]) should:be(1250537080)];
+	
+	RKObjectPropertyMapping* dateMapping = [[mapper mappingPlanForClass:[RKMappableObject class]] mappingForPropertyNamed:@"dateTest"];
+	[expectThat(dateMapping.lastMatchedDateFormat) should:be(@"'Date('ssssssssss'-'ssss')'")];
+	
+	// A value the remembered format rejects falls back to the remaining formats
+	elements = [NSArray arrayWithObject:[NSDictionary dictionaryWithObject:@"08/19/2009" forKey:@"date_test"]];
+	results = [mapper mapObjectsFromArrayOfDictionaries:elements toClass:[RKMappableObject class]];
+	[expectThat([[results lastObject] dateTest]) shouldNot:be(nil)];
+	[expectThat(dateMapping.lastMatchedDateFormat) should:be(@"MM/dd/yyyy")];
+	[mapper release];
+}
+
+- (void)itShouldReuseDateFormattersOnTheSameThread {
+	RKObjectMapper* mapper = [[RKObjectMapper alloc] init];
+	NSArray* elements = [NSArray arrayWithObject:[NSDictionary dictionaryWithObject:@"08/17/2009" forKey:@"date_test"]];
+	[mapper mapObjectsFromArrayOfDictionaries:elements toClass:[RKMappableObject class]];
+	
+	NSDictionary* formatters = [[[NSThread currentThread] threadDictionary] objectForKey:@"RKModelMapperDateFormatters"];
+	NSDateFormatter* formatter = [formatters objectForKey:@"MM/dd/yyyy"];
+	[expectThat(formatter) shouldNot:be(nil)];
+	[expectThat([mapper dateFormatterForFormat:@"MM/dd/yyyy"] == formatter) should:be(YES)];
+	
+	// The built in Rails format is parsed without a formatter
+	[expectThat([formatters objectForKey:@"yyyy-MM-dd'T'HH:mm:ss'Z'"]) should:be(nil)];
+	[mapper release];
+}
+
 
 @end
 
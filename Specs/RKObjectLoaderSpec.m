@@ -0,0 +1,155 @@
+//
+//  RKObjectLoaderSpec.m
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import "RKSpecEnvironment.h"
+#import "RKObjectLoader.h"
+#import "RKSpecResponseLoader.h"
+#import "RKObjectManager.h"
+#import "RKHuman.h"
+#import "Errors.h"
+
+@interface RKRequest (SpecPrivate)
+
+- (void)resetMetrics;
+
+@end
+
+@interface RKObjectLoaderSpec : NSObject <UISpec> {
+	RKRequestMetrics* _collectedMetrics;
+}
+
+- (id)responseWithJSONBody:(NSString*)body;
+- (RKSpecResponseLoader*)loadHumansFromJSONBody:(NSString*)body mapper:(RKObjectMapper*)mapper client:(RKClient*)client;
+
+@end
+
+@implementation RKObjectLoaderSpec
+
+- (void)itShouldFailTheLoadWhenMappingRaisesAnException {
+	RKClient* client = [RKClient clientWithBaseURL:@"http://localhost:4567"];
+	id mapper = [OCMockObject partialMockForObject:[[[RKObjectMapper alloc] init] autorelease]];
+	NSException* exception = [NSException exceptionWithName:NSInternalInconsistencyException reason:@"Unmappable payload" userInfo:nil];
+	[[[mapper stub] andThrow:exception] mapParsedObject:OCMOCK_ANY toClass:OCMOCK_ANY keyPath:OCMOCK_ANY];
+
+	RKSpecResponseLoader* responseLoader = [[[RKSpecResponseLoader alloc] init] autorelease];
+	responseLoader.timeout = 5;
+	RKObjectLoader* loader = [RKObjectLoader loaderWithResourcePath:@"/humans" client:client mapper:mapper delegate:responseLoader];
+	[loader didFinishLoad:[self responseWithJSONBody:@"{\"human\":{}}"]];
+	[responseLoader waitForResponse];
+
+	[expectThat(responseLoader.success) should:be(NO)];
+	[expectThat([responseLoader.failureError domain]) should:be(RKRestKitErrorDomain)];
+	[expectThat([responseLoader.failureError code]) should:be(RKObjectLoaderMappingError)];
+	[expectThat([loader isLoading]) should:be(NO)];
+}
+
+- (void)itShouldHandOverTheObjectsMappedLastTimeForAnUnchangedPayload {
+	RKObjectManager* previousManager = [[RKObjectManager sharedManager] retain];
+	RKObjectManager* objectManager = [[[RKObjectManager alloc] initWithBaseURL:@"http://localhost:4567"] autorelease];
+	RKManagedObjectStore* store = [[[RKManagedObjectStore alloc] initWithStoreFilename:@"RKObjectLoaderSpecs.sqlite"] autorelease];
+	id managedObjectCache = [OCMockObject niceMockForProtocol:@protocol(RKManagedObjectCache)];
+	[[[managedObjectCache stub] andReturn:[NSArray array]] fetchRequestsForResourcePath:OCMOCK_ANY];
+	store.managedObjectCache = managedObjectCache;
+	objectManager.objectStore = store;
+	[RKObjectManager setSharedManager:objectManager];
+	[store removeAllContentFingerprints];
+	RKClient* client = objectManager.client;
+	NSString* body = @"[{\"id\": 2, \"name\": \"Sarah\"}, {\"id\": 1, \"name\": \"Blake\"}]";
+
+	RKSpecResponseLoader* responseLoader = [self loadHumansFromJSONBody:body mapper:[[[RKObjectMapper alloc] init] autorelease] client:client];
+	[expectThat(responseLoader.success) should:be(YES)];
+	NSArray* humans = responseLoader.response;
+	[expectThat([humans count]) should:be(2)];
+	[expectThat([[[humans objectAtIndex:0] railsID] intValue]) should:be(2)];
+	[expectThat([store contentFingerprintForResourcePath:@"/humans"] != nil) should:be(YES)];
+
+	// The same payload is not mapped again, yet the delegate receives the same objects in payload order
+	id mapper = [OCMockObject partialMockForObject:[[[RKObjectMapper alloc] init] autorelease]];
+	[[mapper reject] mapParsedObject:OCMOCK_ANY toClass:OCMOCK_ANY keyPath:OCMOCK_ANY];
+	responseLoader = [self loadHumansFromJSONBody:body mapper:mapper client:client];
+	[expectThat(responseLoader.success) should:be(YES)];
+	[expectThat([responseLoader.response isEqualToArray:humans]) should:be(YES)];
+
+	// Deleting one of the objects invalidates the fingerprint
+	[[store managedObjectContext] deleteObject:[humans objectAtIndex:1]];
+	[store save];
+	responseLoader = [self loadHumansFromJSONBody:body mapper:[[[RKObjectMapper alloc] init] autorelease] client:client];
+	[expectThat(responseLoader.success) should:be(YES)];
+	[expectThat([responseLoader.response count]) should:be(2)];
+	[expectThat([[[responseLoader.response objectAtIndex:1] railsID] intValue]) should:be(1)];
+
+	[store deletePersistantStore];
+	[RKObjectManager setSharedManager:previousManager];
+	[previousManager release];
+}
+
+- (BOOL)collectMetrics:(RKRequestMetrics*)metrics {
+	[_collectedMetrics release];
+	_collectedMetrics = [metrics retain];
+	return YES;
+}
+
+- (void)itShouldReportTheTimeSpentMappingAndSavingToTheMetricsSink {
+	RKObjectManager* previousManager = [[RKObjectManager sharedManager] retain];
+	RKObjectManager* objectManager = [[[RKObjectManager alloc] initWithBaseURL:@"http://localhost:4567"] autorelease];
+	RKManagedObjectStore* store = [[[RKManagedObjectStore alloc] initWithStoreFilename:@"RKObjectLoaderSpecs.sqlite"] autorelease];
+	objectManager.objectStore = store;
+	[RKObjectManager setSharedManager:objectManager];
+	[store removeAllContentFingerprints];
+
+	id metricsSink = [OCMockObject niceMockForProtocol:@protocol(RKRequestMetricsSink)];
+	RKSpecResponseLoader* responseLoader = [[[RKSpecResponseLoader alloc] init] autorelease];
+	responseLoader.timeout = 10;
+	RKObjectLoader* loader = [RKObjectLoader loaderWithResourcePath:@"/humans" client:objectManager.client
+															 mapper:[[[RKObjectMapper alloc] init] autorelease] delegate:responseLoader];
+	[[metricsSink expect] request:loader didCollectMetrics:[OCMArg checkWithSelector:@selector(collectMetrics:) onObject:self]];
+	loader.objectClass = [RKHuman class];
+	loader.managedObjectStore = store;
+	loader.metricsSink = metricsSink;
+	[loader resetMetrics];
+	[loader didFinishLoad:[self responseWithJSONBody:@"[{\"id\": 2, \"name\": \"Sarah\"}, {\"id\": 1, \"name\": \"Blake\"}]"]];
+	[responseLoader waitForResponse];
+
+	[expectThat(responseLoader.success) should:be(YES)];
+	[metricsSink verify];
+	[expectThat(_collectedMetrics == loader.metrics) should:be(YES)];
+	[expectThat(_collectedMetrics.parseDuration > 0) should:be(YES)];
+	[expectThat(_collectedMetrics.mappingDuration > 0) should:be(YES)];
+	[expectThat(_collectedMetrics.saveDuration > 0) should:be(YES)];
+	[expectThat(_collectedMetrics.mergeDuration > 0) should:be(YES)];
+	[expectThat(_collectedMetrics.completionTime > 0) should:be(YES)];
+	[_collectedMetrics release];
+	_collectedMetrics = nil;
+
+	[store deletePersistantStore];
+	[RKObjectManager setSharedManager:previousManager];
+	[previousManager release];
+}
+
+- (RKSpecResponseLoader*)loadHumansFromJSONBody:(NSString*)body mapper:(RKObjectMapper*)mapper client:(RKClient*)client {
+	RKSpecResponseLoader* responseLoader = [[[RKSpecResponseLoader alloc] init] autorelease];
+	responseLoader.timeout = 10;
+	RKObjectLoader* loader = [RKObjectLoader loaderWithResourcePath:@"/humans" client:client mapper:mapper delegate:responseLoader];
+	loader.objectClass = [RKHuman class];
+	loader.managedObjectStore = [[RKObjectManager sharedManager] objectStore];
+	[loader didFinishLoad:[self responseWithJSONBody:body]];
+	[responseLoader waitForResponse];
+	return responseLoader;
+}
+
+// A successful JSON response that was buffered rather than parsed incrementally
+- (id)responseWithJSONBody:(NSString*)body {
+	id response = [OCMockObject niceMockForClass:[RKResponse class]];
+	BOOL yes = YES;
+	[[[response stub] andReturnValue:OCMOCK_VALUE(yes)] isSuccessful];
+	[[[response stub] andReturnValue:OCMOCK_VALUE(yes)] isJSON];
+	[[[response stub] andReturn:[body dataUsingEncoding:NSUTF8StringEncoding]] body];
+	return response;
+}
+
+@end
@@ -0,0 +1,141 @@
+//
+//  RKObjectMappingQueueSpec.m
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import "RKSpecEnvironment.h"
+#import "RKObjectMappingQueue.h"
+
+@interface RKObjectMappingQueueSpec : NSObject <UISpec> {
+	NSMutableArray* _performedNumbers;
+	NSConditionLock* _gate;
+	BOOL _backgroundSubmissionReturned;
+}
+
+- (void)recordNumber:(NSNumber*)number;
+- (void)recordNumberWhenOpened:(NSNumber*)number;
+- (void)submitNumberFromBackground:(NSArray*)queueAndNumber;
+- (NSUInteger)performedCount;
+- (void)waitForPerformedCount:(NSUInteger)count;
+- (void)waitForPendingOperationCount:(NSUInteger)count ofQueue:(RKObjectMappingQueue*)queue;
+
+@end
+
+@implementation RKObjectMappingQueueSpec
+
+- (void)before {
+	_performedNumbers = [[NSMutableArray alloc] init];
+	_gate = [[NSConditionLock alloc] initWithCondition:0];
+	_backgroundSubmissionReturned = NO;
+}
+
+- (void)after {
+	[_performedNumbers release];
+	[_gate release];
+}
+
+- (void)itShouldPerformOperationsInTheOrderTheyWereAdded {
+	RKObjectMappingQueue* queue = [[[RKObjectMappingQueue alloc] initWithNumberOfThreads:1 maxPendingOperations:100] autorelease];
+	NSMutableArray* numbers = [NSMutableArray array];
+	int i;
+	for (i = 0; i < 50; i++) {
+		[numbers addObject:[NSNumber numberWithInt:i]];
+		[queue addOperationWithTarget:self selector:@selector(recordNumber:) object:[numbers lastObject]];
+	}
+
+	[self waitForPerformedCount:50];
+	@synchronized(_performedNumbers) {
+		[expectThat([_performedNumbers isEqualToArray:numbers]) should:be(YES)];
+	}
+}
+
+- (void)itShouldBlockBackgroundSubmittersUntilTheQueueHasRoom {
+	RKObjectMappingQueue* queue = [[[RKObjectMappingQueue alloc] initWithNumberOfThreads:1 maxPendingOperations:1] autorelease];
+
+	// Occupy the only worker
+	[queue addOperationWithTarget:self selector:@selector(recordNumberWhenOpened:) object:[NSNumber numberWithInt:0]];
+	[self waitForPendingOperationCount:0 ofQueue:queue];
+
+	[queue addOperationWithTarget:self selector:@selector(recordNumber:) object:[NSNumber numberWithInt:1]];
+	[expectThat(queue.isSaturated) should:be(YES)];
+
+	// The main thread is never blocked, but its work waits for room instead of overfilling the queue
+	[queue addOperationWithTarget:self selector:@selector(recordNumber:) object:[NSNumber numberWithInt:2]];
+	[expectThat(queue.pendingOperationCount) should:be(1)];
+	[expectThat(queue.deferredOperationCount) should:be(1)];
+
+	NSArray* queueAndNumber = [NSArray arrayWithObjects:queue, [NSNumber numberWithInt:3], nil];
+	[NSThread detachNewThreadSelector:@selector(submitNumberFromBackground:) toTarget:self withObject:queueAndNumber];
+	[[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.3]];
+	[expectThat(_backgroundSubmissionReturned) should:be(NO)];
+
+	[_gate lock];
+	[_gate unlockWithCondition:1];
+	[self waitForPerformedCount:4];
+	[expectThat(_backgroundSubmissionReturned) should:be(YES)];
+	[expectThat(queue.deferredOperationCount) should:be(0)];
+	NSArray* expectedNumbers = [NSArray arrayWithObjects:[NSNumber numberWithInt:0], [NSNumber numberWithInt:1],
+								[NSNumber numberWithInt:2], [NSNumber numberWithInt:3], nil];
+	@synchronized(_performedNumbers) {
+		[expectThat([_performedNumbers isEqualToArray:expectedNumbers]) should:be(YES)];
+	}
+}
+
+- (void)itShouldKeepPerformingOperationsAfterOneRaises {
+	RKObjectMappingQueue* queue = [[[RKObjectMappingQueue alloc] initWithNumberOfThreads:1 maxPendingOperations:10] autorelease];
+	[queue addOperationWithTarget:self selector:@selector(recordNumber:) object:@"not a number"];
+	[queue addOperationWithTarget:self selector:@selector(recordNumber:) object:[NSNumber numberWithInt:1]];
+	[self waitForPerformedCount:1];
+	@synchronized(_performedNumbers) {
+		[expectThat([_performedNumbers lastObject]) should:be([NSNumber numberWithInt:1])];
+	}
+}
+
+- (void)recordNumber:(NSNumber*)number {
+	if (NO == [number isKindOfClass:[NSNumber class]]) {
+		[NSException raise:NSInvalidArgumentException format:@"%@ is not a number", number];
+	}
+
+	@synchronized(_performedNumbers) {
+		[_performedNumbers addObject:number];
+	}
+}
+
+- (void)recordNumberWhenOpened:(NSNumber*)number {
+	[_gate lockWhenCondition:1];
+	[_gate unlock];
+	[self recordNumber:number];
+}
+
+- (void)submitNumberFromBackground:(NSArray*)queueAndNumber {
+	NSAutoreleasePool* pool = [[NSAutoreleasePool alloc] init];
+	RKObjectMappingQueue* queue = [queueAndNumber objectAtIndex:0];
+	[queue addOperationWithTarget:self selector:@selector(recordNumber:) object:[queueAndNumber objectAtIndex:1]];
+	_backgroundSubmissionReturned = YES;
+	[pool drain];
+}
+
+- (NSUInteger)performedCount {
+	@synchronized(_performedNumbers) {
+		return [_performedNumbers count];
+	}
+}
+
+- (void)waitForPerformedCount:(NSUInteger)count {
+	NSDate* timeoutDate = [NSDate dateWithTimeIntervalSinceNow:5];
+	while ([self performedCount] < count && [timeoutDate timeIntervalSinceNow] > 0) {
+		[[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+	}
+}
+
+- (void)waitForPendingOperationCount:(NSUInteger)count ofQueue:(RKObjectMappingQueue*)queue {
+	NSDate* timeoutDate = [NSDate dateWithTimeIntervalSinceNow:5];
+	while (queue.pendingOperationCount != count && [timeoutDate timeIntervalSinceNow] > 0) {
+		[[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+	}
+}
+
+@end
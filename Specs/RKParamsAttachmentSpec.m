@@ -8,6 +8,7 @@
 
 #import "RKSpecEnvironment.h"
 #import "RKParamsAttachment.h"
+#import "RKParams.h"
 
 @interface RKParamsAttachmentSpec : NSObject <UISpec> {
 }
@@ -28,4 +29,58 @@
 	[expectThat(exception) shouldNot:be(nil)];
 }
 
+- (void)itShouldStreamTheMultiPartBodyFromPrecomputedSegments {
+	RKParams* params = [RKParams params];
+	NSString* filePath = [[NSBundle mainBundle] pathForResource:@"blake" ofType:@"png"];
+	[params setFile:filePath forParam:@"file"];
+	[params setValue:@"this is the value" forParam:@"test"];
+	[params setData:[@"some data" dataUsingEncoding:NSUTF8StringEncoding] MIMEType:@"text/plain" forParam:@"data"];
+	NSUInteger contentLength = [params HTTPHeaderValueForContentLength];
+	
+	NSInputStream* stream = [params HTTPBodyStream];
+	NSMutableData* readBody = [NSMutableData data];
+	uint8_t buffer[1000];
+	NSInteger bytesRead;
+	[stream open];
+	while ((bytesRead = [stream read:buffer maxLength:sizeof(buffer)]) > 0) {
+		[readBody appendBytes:buffer length:bytesRead];
+	}
+	[stream close];
+	[expectThat([readBody length]) should:be(contentLength)];
+	
+	// Rebuilding the segments rewinds the stream, which can then be consumed without copying
+	stream = [params HTTPBodyStream];
+	NSMutableData* bufferedBody = [NSMutableData data];
+	uint8_t* segment;
+	NSUInteger length;
+	[stream open];
+	while ([stream getBuffer:&segment length:&length]) {
+		[bufferedBody appendBytes:segment length:length];
+	}
+	[stream close];
+	[expectThat([bufferedBody isEqualToData:readBody]) should:be(YES)];
+	
+	NSString* footer = [NSString stringWithFormat:@"--%@--\r\n", [[[params HTTPHeaderValueForContentType] componentsSeparatedByString:@"boundary="] lastObject]];
+	NSData* footerData = [footer dataUsingEncoding:NSUTF8StringEncoding];
+	NSData* tail = [readBody subdataWithRange:NSMakeRange([readBody length] - [footerData length], [footerData length])];
+	[expectThat([tail isEqualToData:footerData]) should:be(YES)];
+}
+
+- (void)itShouldFailTheStreamWhenAnAttachedFileShrinksBeforeItIsSent {
+	NSString* filePath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"RKParamsAttachmentSpec.txt"];
+	[[@"the original contents" dataUsingEncoding:NSUTF8StringEncoding] writeToFile:filePath atomically:YES];
+	RKParams* params = [RKParams params];
+	[params setFile:filePath forParam:@"file"];
+	[[@"shorter" dataUsingEncoding:NSUTF8StringEncoding] writeToFile:filePath atomically:YES];
+	
+	NSInputStream* stream = [params HTTPBodyStream];
+	uint8_t buffer[1000];
+	[stream open];
+	[expectThat([stream read:buffer maxLength:sizeof(buffer)]) should:be(-1)];
+	[expectThat([stream streamStatus]) should:be(NSStreamStatusError)];
+	[expectThat([stream streamError]) shouldNot:be(nil)];
+	[stream close];
+	[[NSFileManager defaultManager] removeItemAtPath:filePath error:nil];
+}
+
 @end
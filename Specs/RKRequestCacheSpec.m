@@ -0,0 +1,206 @@
+//
+//  RKRequestCacheSpec.m
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import "RKSpecEnvironment.h"
+#import "RKRequestCache.h"
+#import "RKObjectLoader.h"
+#import "RKManagedObjectStore.h"
+#import "RKSpecResponseLoader.h"
+
+@interface RKRequestCacheSpec : NSObject <UISpec> {
+	RKRequestCache* _cache;
+	RKResponse* _loadedResponse;
+}
+
+- (RKRequest*)requestWithURL:(NSString*)URLString;
+- (RKResponse*)responseForRequest:(RKRequest*)request body:(NSString*)body headers:(NSDictionary*)headers;
+- (void)didFinishLoad:(RKResponse*)response;
+
+@end
+
+@implementation RKRequestCacheSpec
+
+- (void)beforeAll {
+	_cache = [[RKRequestCache alloc] initWithCachePath:[NSTemporaryDirectory() stringByAppendingPathComponent:@"RKRequestCacheSpec"]];
+}
+
+- (void)afterAll {
+	[_cache invalidateAll];
+	[_cache release];
+}
+
+- (void)before {
+	[_cache invalidateAll];
+	_cache.maximumDiskSize = 0;
+	_loadedResponse = nil;
+}
+
+- (void)itShouldOnlyStoreResponsesThatCanBeRevalidated {
+	RKRequest* request = [self requestWithURL:@"http://restkit.org/humans"];
+	NSDictionary* headers = [NSDictionary dictionaryWithObjectsAndKeys:@"\"1234\"", @"ETag", nil];
+	[_cache storeResponse:[self responseForRequest:request body:@"[]" headers:headers] forRequest:request];
+	RKResponse* cachedResponse = [_cache responseForRequest:request];
+	[expectThat([cachedResponse wasLoadedFromCache]) should:be(YES)];
+	[expectThat([cachedResponse statusCode]) should:be(200)];
+	[expectThat([cachedResponse bodyAsString]) should:be(@"[]")];
+	[expectThat([cachedResponse isJSON]) should:be(YES)];
+
+	RKRequest* unvalidatedRequest = [self requestWithURL:@"http://restkit.org/cats"];
+	[_cache storeResponse:[self responseForRequest:unvalidatedRequest body:@"[]" headers:nil] forRequest:unvalidatedRequest];
+	[expectThat([_cache hasResponseForRequest:unvalidatedRequest]) should:be(NO)];
+
+	RKRequest* noStoreRequest = [self requestWithURL:@"http://restkit.org/dogs"];
+	headers = [NSDictionary dictionaryWithObjectsAndKeys:@"\"1234\"", @"ETag", @"private, no-store", @"Cache-Control", nil];
+	[_cache storeResponse:[self responseForRequest:noStoreRequest body:@"[]" headers:headers] forRequest:noStoreRequest];
+	[expectThat([_cache hasResponseForRequest:noStoreRequest]) should:be(NO)];
+}
+
+- (void)itShouldAddConditionalHeadersForCachedResponses {
+	RKRequest* request = [self requestWithURL:@"http://restkit.org/humans"];
+	NSDictionary* headers = [NSDictionary dictionaryWithObjectsAndKeys:@"\"1234\"", @"Etag",
+							 @"Sat, 17 Oct 2026 10:00:00 GMT", @"Last-Modified", nil];
+	[_cache storeResponse:[self responseForRequest:request body:@"[]" headers:headers] forRequest:request];
+
+	RKRequest* revalidation = [self requestWithURL:@"http://restkit.org/humans"];
+	[_cache addConditionalHeadersToRequest:revalidation];
+	[expectThat([[revalidation URLRequest] valueForHTTPHeaderField:@"If-None-Match"]) should:be(@"\"1234\"")];
+	[expectThat([[revalidation URLRequest] valueForHTTPHeaderField:@"If-Modified-Since"]) should:be(@"Sat, 17 Oct 2026 10:00:00 GMT")];
+
+	// Conditional headers set by the caller win
+	RKRequest* conditionalRequest = [self requestWithURL:@"http://restkit.org/humans"];
+	[[conditionalRequest URLRequest] setValue:@"\"5678\"" forHTTPHeaderField:@"If-None-Match"];
+	[_cache addConditionalHeadersToRequest:conditionalRequest];
+	[expectThat([[conditionalRequest URLRequest] valueForHTTPHeaderField:@"If-None-Match"]) should:be(@"\"5678\"")];
+
+	RKRequest* uncachedRequest = [self requestWithURL:@"http://restkit.org/cats"];
+	[_cache addConditionalHeadersToRequest:uncachedRequest];
+	[expectThat([[uncachedRequest URLRequest] valueForHTTPHeaderField:@"If-None-Match"]) should:be(nil)];
+}
+
+- (void)itShouldFinishANotModifiedResponseWithTheCachedResponse {
+	RKRequest* request = [self requestWithURL:@"http://restkit.org/humans"];
+	NSDictionary* headers = [NSDictionary dictionaryWithObjectsAndKeys:@"\"1234\"", @"ETag", nil];
+	[_cache storeResponse:[self responseForRequest:request body:@"[{\"id\": 1}]" headers:headers] forRequest:request];
+
+	request.cache = _cache;
+	id mockRequest = [OCMockObject partialMockForObject:request];
+	[[[mockRequest stub] andCall:@selector(didFinishLoad:) onObject:self] didFinishLoad:OCMOCK_ANY];
+	id URLResponse = [OCMockObject niceMockForClass:[NSHTTPURLResponse class]];
+	NSInteger statusCode = 304;
+	long long expectedContentLength = 0;
+	[[[URLResponse stub] andReturnValue:OCMOCK_VALUE(statusCode)] statusCode];
+	[[[URLResponse stub] andReturnValue:OCMOCK_VALUE(expectedContentLength)] expectedContentLength];
+	[[[URLResponse stub] andReturn:[NSDictionary dictionaryWithObject:@"\"1234\"" forKey:@"ETag"]] allHeaderFields];
+
+	RKResponse* response = [[[RKResponse alloc] initWithRequest:mockRequest] autorelease];
+	[response connection:nil didReceiveResponse:URLResponse];
+	[response connectionDidFinishLoading:nil];
+	[expectThat(_loadedResponse != response) should:be(YES)];
+	[expectThat([_loadedResponse wasLoadedFromCache]) should:be(YES)];
+	[expectThat([_loadedResponse statusCode]) should:be(200)];
+	[expectThat([_loadedResponse bodyAsString]) should:be(@"[{\"id\": 1}]")];
+}
+
+- (void)itShouldKeepAnEntryPerValueOfTheVaryHeaders {
+	RKRequest* JSONRequest = [self requestWithURL:@"http://restkit.org/humans"];
+	[[JSONRequest URLRequest] setValue:@"application/json" forHTTPHeaderField:@"Accept"];
+	NSDictionary* headers = [NSDictionary dictionaryWithObjectsAndKeys:@"\"1234\"", @"ETag", @"Accept", @"Vary", nil];
+	[_cache storeResponse:[self responseForRequest:JSONRequest body:@"[]" headers:headers] forRequest:JSONRequest];
+	[expectThat([_cache hasResponseForRequest:JSONRequest]) should:be(YES)];
+
+	RKRequest* XMLRequest = [self requestWithURL:@"http://restkit.org/humans"];
+	[[XMLRequest URLRequest] setValue:@"application/xml" forHTTPHeaderField:@"Accept"];
+	[expectThat([_cache hasResponseForRequest:XMLRequest]) should:be(NO)];
+
+	// Responses varying on every header can never be matched
+	RKRequest* request = [self requestWithURL:@"http://restkit.org/cats"];
+	headers = [NSDictionary dictionaryWithObjectsAndKeys:@"\"1234\"", @"ETag", @"*", @"Vary", nil];
+	[_cache storeResponse:[self responseForRequest:request body:@"[]" headers:headers] forRequest:request];
+	[expectThat([_cache hasResponseForRequest:request]) should:be(NO)];
+}
+
+- (void)itShouldRemoveTheLeastRecentlyUsedEntriesBeyondTheMaximumDiskSize {
+	NSMutableString* body = [NSMutableString string];
+	while ([body length] < 4096) {
+		[body appendString:@"{\"id\": 1, \"name\": \"Blake Watters\"},"];
+	}
+	NSDictionary* headers = [NSDictionary dictionaryWithObjectsAndKeys:@"\"1234\"", @"ETag", nil];
+	RKRequest* firstRequest = [self requestWithURL:@"http://restkit.org/humans/1"];
+	RKRequest* secondRequest = [self requestWithURL:@"http://restkit.org/humans/2"];
+	RKRequest* thirdRequest = [self requestWithURL:@"http://restkit.org/humans/3"];
+
+	// Modification dates have a resolution of a second on some file systems
+	[_cache storeResponse:[self responseForRequest:firstRequest body:body headers:headers] forRequest:firstRequest];
+	unsigned long long entrySize = _cache.diskSize;
+	[expectThat(entrySize > 4096) should:be(YES)];
+	[NSThread sleepForTimeInterval:1.1];
+	[_cache storeResponse:[self responseForRequest:secondRequest body:body headers:headers] forRequest:secondRequest];
+	[NSThread sleepForTimeInterval:1.1];
+	[expectThat([_cache responseForRequest:firstRequest] != nil) should:be(YES)];
+	[NSThread sleepForTimeInterval:1.1];
+
+	_cache.maximumDiskSize = (NSUInteger)(entrySize * 5 / 2);
+	[_cache storeResponse:[self responseForRequest:thirdRequest body:body headers:headers] forRequest:thirdRequest];
+	[expectThat([_cache hasResponseForRequest:firstRequest]) should:be(YES)];
+	[expectThat([_cache hasResponseForRequest:secondRequest]) should:be(NO)];
+	[expectThat([_cache hasResponseForRequest:thirdRequest]) should:be(YES)];
+	[expectThat(_cache.diskSize <= _cache.maximumDiskSize) should:be(YES)];
+}
+
+- (void)itShouldOnlyMapCachedResponsesWhenTheLoaderMapsCachedResponses {
+	id managedObjectCache = [OCMockObject niceMockForProtocol:@protocol(RKManagedObjectCache)];
+	[[[managedObjectCache stub] andReturn:[NSArray array]] fetchRequestsForResourcePath:OCMOCK_ANY];
+	id objectStore = [OCMockObject niceMockForClass:[RKManagedObjectStore class]];
+	[[[objectStore stub] andReturn:managedObjectCache] managedObjectCache];
+	RKClient* client = [[[RKClient alloc] init] autorelease];
+	client.baseURL = @"http://restkit.org";
+	NSDictionary* headers = [NSDictionary dictionaryWithObjectsAndKeys:@"\"1234\"", @"ETag", nil];
+
+	// The objects of the managed object cache are handed over straight away
+	RKSpecResponseLoader* responseLoader = [[[RKSpecResponseLoader alloc] init] autorelease];
+	id mapper = [OCMockObject partialMockForObject:[[[RKObjectMapper alloc] init] autorelease]];
+	[[mapper reject] mapParsedObject:OCMOCK_ANY toClass:OCMOCK_ANY keyPath:OCMOCK_ANY];
+	RKObjectLoader* loader = [RKObjectLoader loaderWithResourcePath:@"/humans" client:client mapper:mapper delegate:responseLoader];
+	loader.managedObjectStore = objectStore;
+	loader.mapsCachedResponses = NO;
+	[loader didFinishLoad:[self responseForRequest:loader body:@"[]" headers:headers]];
+	[expectThat(responseLoader.success) should:be(YES)];
+	[mapper verify];
+
+	responseLoader = [[[RKSpecResponseLoader alloc] init] autorelease];
+	responseLoader.timeout = 5;
+	mapper = [OCMockObject partialMockForObject:[[[RKObjectMapper alloc] init] autorelease]];
+	[[[mapper expect] andReturn:[NSArray array]] mapParsedObject:OCMOCK_ANY toClass:OCMOCK_ANY keyPath:OCMOCK_ANY];
+	loader = [RKObjectLoader loaderWithResourcePath:@"/humans" client:client mapper:mapper delegate:responseLoader];
+	loader.managedObjectStore = objectStore;
+	[loader didFinishLoad:[self responseForRequest:loader body:@"[]" headers:headers]];
+	[responseLoader waitForResponse];
+	[expectThat(responseLoader.success) should:be(YES)];
+	[mapper verify];
+}
+
+- (RKRequest*)requestWithURL:(NSString*)URLString {
+	return [[[RKRequest alloc] initWithURL:[NSURL URLWithString:URLString]] autorelease];
+}
+
+// A successful JSON response as the cache would hand it back
+- (RKResponse*)responseForRequest:(RKRequest*)request body:(NSString*)body headers:(NSDictionary*)headers {
+	NSMutableDictionary* headerFields = [NSMutableDictionary dictionaryWithObject:@"application/json" forKey:@"Content-Type"];
+	[headerFields addEntriesFromDictionary:headers];
+	return [[[RKResponse alloc] initWithRequest:request
+									 cachedBody:[body dataUsingEncoding:NSUTF8StringEncoding]
+									 statusCode:200
+									   MIMEType:@"application/json"
+								   headerFields:headerFields] autorelease];
+}
+
+- (void)didFinishLoad:(RKResponse*)response {
+	_loadedResponse = response;
+}
+
+@end
@@ -10,14 +10,104 @@
 #import "RKRequest.h"
 #import "RKParams.h"
 #import "RKResponse.h"
+#import "RKRequestQueue.h"
+#import "RKClient.h"
+#import "RKRequestRetryPolicy.h"
+#import "RKRequestMetrics.h"
+#import "RKGzipInputStream.h"
+#import "RKJSONSerialization.h"
+
+@interface RKRequest (SpecPrivate)
+
+- (void)prepareURLRequest;
+
+@end
+
+// A body of known bytes without a stream or length of its own
+@interface RKRequestSpecBody : NSObject <RKRequestSerializable> {
+	NSData* _data;
+}
+
+- (id)initWithLength:(NSUInteger)length;
+
+@end
+
+@implementation RKRequestSpecBody
+
+- (id)initWithLength:(NSUInteger)length {
+	if ((self = [super init])) {
+		NSMutableData* data = [NSMutableData dataWithCapacity:length];
+		NSData* element = [@"{\"id\": 1, \"name\": \"Blake Watters\"}," dataUsingEncoding:NSUTF8StringEncoding];
+		while ([data length] < length) {
+			[data appendData:element];
+		}
+		[data setLength:length];
+		_data = [data retain];
+	}
+
+	return self;
+}
+
+- (void)dealloc {
+	[_data release];
+	[super dealloc];
+}
+
+- (NSString*)HTTPHeaderValueForContentType {
+	return @"application/json";
+}
+
+- (NSData*)HTTPBody {
+	return _data;
+}
+
+@end
+
+// Records the order the queue dispatches requests in instead of opening a connection
+@interface RKRequestQueueSpecRequest : RKRequest {
+	NSMutableArray* _dispatchedRequests;
+}
+
+@property (nonatomic, assign) NSMutableArray* dispatchedRequests;
+
+@end
+
+@implementation RKRequestQueueSpecRequest
+
+@synthesize dispatchedRequests = _dispatchedRequests;
+
+- (void)fireAsynchronousRequest {
+	[_dispatchedRequests addObject:self];
+}
+
+@end
 
 @interface RKRequestSpec : NSObject <UISpec> {
+	RKClient* _previousClient;
+	RKClient* _client;
 }
 
+- (RKRequestQueueSpecRequest*)requestWithURL:(NSString*)URLString priority:(RKRequestPriority)priority dispatchedRequests:(NSMutableArray*)dispatchedRequests;
+
 @end
 
 @implementation RKRequestSpec
 
+// The queue holds requests back until the reachability of the shared client's base URL is known,
+// which it is straight away for an IP address
+- (void)beforeAll {
+	_previousClient = [[RKClient sharedClient] retain];
+	_client = [[RKClient alloc] init];
+	_client.baseURL = @"http://127.0.0.1:4567";
+	[RKClient setSharedClient:_client];
+}
+
+- (void)afterAll {
+	[RKClient setSharedClient:_previousClient];
+	[_previousClient release];
+	[_client release];
+}
+
 /**
  * This spec requires the test Sinatra server to be running
  * `ruby Specs/server.rb`
@@ -37,4 +127,341 @@
 	[expectThat(response.statusCode) should:be(200)];
 }
 
+- (void)itShouldCoalesceIdenticalGETRequests {
+	RKRequestQueue* queue = [[RKRequestQueue alloc] init];
+	queue.coalescesRequests = YES;
+	queue.suspended = YES;
+	NSURL* URL = [NSURL URLWithString:@"http://restkit.org/humans"];
+	RKRequest* firstRequest = [[[RKRequest alloc] initWithURL:URL] autorelease];
+	RKRequest* secondRequest = [[[RKRequest alloc] initWithURL:URL] autorelease];
+	RKRequest* postRequest = [[[RKRequest alloc] initWithURL:URL] autorelease];
+	postRequest.method = RKRequestMethodPOST;
+	[queue sendRequest:firstRequest];
+	[queue sendRequest:secondRequest];
+	[queue sendRequest:postRequest];
+	[expectThat(queue.pendingCount) should:be(2)];
+	[expectThat([[firstRequest coalescedRequests] count]) should:be(1)];
+	
+	[queue cancelRequest:secondRequest];
+	[expectThat([[firstRequest coalescedRequests] count]) should:be(0)];
+	[queue cancelAllRequests];
+	[queue release];
+}
+
+- (void)itShouldNotCoalesceRequestsByDefault {
+	RKRequestQueue* queue = [[RKRequestQueue alloc] init];
+	queue.suspended = YES;
+	NSURL* URL = [NSURL URLWithString:@"http://restkit.org/humans"];
+	RKRequest* firstRequest = [[[RKRequest alloc] initWithURL:URL] autorelease];
+	RKRequest* secondRequest = [[[RKRequest alloc] initWithURL:URL] autorelease];
+	[queue sendRequest:firstRequest];
+	[queue sendRequest:secondRequest];
+	[expectThat(queue.pendingCount) should:be(2)];
+	[expectThat([[firstRequest coalescedRequests] count]) should:be(0)];
+	[queue cancelAllRequests];
+	[queue release];
+}
+
+- (void)itShouldKeepCredentialsOutOfTheCoalescingKey {
+	NSURL* URL = [NSURL URLWithString:@"http://restkit.org/humans"];
+	RKRequest* request = [[[RKRequest alloc] initWithURL:URL] autorelease];
+	request.username = @"blake";
+	request.password = @"s3cr3t";
+	RKRequest* otherRequest = [[[RKRequest alloc] initWithURL:URL] autorelease];
+	otherRequest.username = @"blake";
+	otherRequest.password = @"0th3r";
+	[expectThat([[request coalescingKey] rangeOfString:@"s3cr3t"].location == NSNotFound) should:be(YES)];
+	[expectThat([[request coalescingKey] isEqualToString:[otherRequest coalescingKey]]) should:be(NO)];
+}
+
+- (void)itShouldDispatchRequestsByLaneWithinTheConcurrencyLimits {
+	RKRequestQueue* queue = [[RKRequestQueue alloc] init];
+	queue.maxConcurrentRequests = 4;
+	queue.maxConcurrentRequestsPerHost = 2;
+	queue.maxConcurrentBackgroundRequests = 1;
+	queue.suspended = YES;
+	NSMutableArray* dispatchedRequests = [NSMutableArray array];
+	RKRequestQueueSpecRequest* backgroundA = [self requestWithURL:@"http://a.restkit.org/1" priority:RKRequestPriorityBackground dispatchedRequests:dispatchedRequests];
+	RKRequestQueueSpecRequest* backgroundB = [self requestWithURL:@"http://b.restkit.org/1" priority:RKRequestPriorityBackground dispatchedRequests:dispatchedRequests];
+	RKRequestQueueSpecRequest* defaultA1 = [self requestWithURL:@"http://a.restkit.org/2" priority:RKRequestPriorityDefault dispatchedRequests:dispatchedRequests];
+	RKRequestQueueSpecRequest* defaultA2 = [self requestWithURL:@"http://a.restkit.org/3" priority:RKRequestPriorityDefault dispatchedRequests:dispatchedRequests];
+	RKRequestQueueSpecRequest* defaultA3 = [self requestWithURL:@"http://a.restkit.org/4" priority:RKRequestPriorityDefault dispatchedRequests:dispatchedRequests];
+	RKRequestQueueSpecRequest* interactiveC = [self requestWithURL:@"http://c.restkit.org/1" priority:RKRequestPriorityInteractive dispatchedRequests:dispatchedRequests];
+	for (RKRequest* request in [NSArray arrayWithObjects:backgroundA, backgroundB, defaultA1, defaultA2, defaultA3, interactiveC, nil]) {
+		[queue sendRequest:request];
+	}
+	[expectThat([dispatchedRequests count]) should:be(0)];
+
+	// The third request to a.restkit.org waits for the host, and background requests leave the last global slot free
+	queue.suspended = NO;
+	NSArray* expectedRequests = [NSArray arrayWithObjects:interactiveC, defaultA1, defaultA2, nil];
+	[expectThat([dispatchedRequests isEqualToArray:expectedRequests]) should:be(YES)];
+
+	// Background requests leave the last slot of a.restkit.org free too
+	[queue cancelRequest:interactiveC];
+	expectedRequests = [expectedRequests arrayByAddingObject:backgroundB];
+	[expectThat([dispatchedRequests isEqualToArray:expectedRequests]) should:be(YES)];
+	[queue cancelRequest:defaultA1];
+	expectedRequests = [expectedRequests arrayByAddingObject:defaultA3];
+	[expectThat([dispatchedRequests isEqualToArray:expectedRequests]) should:be(YES)];
+
+	// A loading request leaves the background limit it was dispatched under, whatever its priority is now
+	backgroundB.priority = RKRequestPriorityDefault;
+	[queue cancelRequest:backgroundB];
+	[queue cancelRequest:defaultA2];
+	[queue cancelRequest:defaultA3];
+	expectedRequests = [expectedRequests arrayByAddingObject:backgroundA];
+	[expectThat([dispatchedRequests isEqualToArray:expectedRequests]) should:be(YES)];
+
+	[queue cancelAllRequests];
+	[queue release];
+}
+
+- (void)itShouldDispatchTheRequestsOfEachHostInOrderTakingTurnsBetweenHosts {
+	RKRequestQueue* queue = [[RKRequestQueue alloc] init];
+	queue.maxConcurrentRequests = 1;
+	queue.suspended = YES;
+	NSMutableArray* dispatchedRequests = [NSMutableArray array];
+	RKRequestQueueSpecRequest* requestA1 = [self requestWithURL:@"http://a.restkit.org/1" priority:RKRequestPriorityDefault dispatchedRequests:dispatchedRequests];
+	RKRequestQueueSpecRequest* requestA2 = [self requestWithURL:@"http://a.restkit.org/2" priority:RKRequestPriorityDefault dispatchedRequests:dispatchedRequests];
+	RKRequestQueueSpecRequest* requestA3 = [self requestWithURL:@"http://a.restkit.org/3" priority:RKRequestPriorityDefault dispatchedRequests:dispatchedRequests];
+	RKRequestQueueSpecRequest* requestB1 = [self requestWithURL:@"http://b.restkit.org/1" priority:RKRequestPriorityDefault dispatchedRequests:dispatchedRequests];
+	RKRequestQueueSpecRequest* requestB2 = [self requestWithURL:@"http://b.restkit.org/2" priority:RKRequestPriorityDefault dispatchedRequests:dispatchedRequests];
+	RKRequestQueueSpecRequest* requestC1 = [self requestWithURL:@"http://c.restkit.org/1" priority:RKRequestPriorityDefault dispatchedRequests:dispatchedRequests];
+	for (RKRequest* request in [NSArray arrayWithObjects:requestA1, requestA2, requestA3, requestB1, requestB2, requestC1, nil]) {
+		[queue sendRequest:request];
+	}
+
+	// Each finished request hands its slot to the next host in turn
+	queue.suspended = NO;
+	while ([queue loadingCount] > 0) {
+		[queue cancelRequest:[dispatchedRequests lastObject]];
+	}
+	NSArray* expectedRequests = [NSArray arrayWithObjects:requestA1, requestB1, requestC1, requestA2, requestB2, requestA3, nil];
+	[expectThat([dispatchedRequests isEqualToArray:expectedRequests]) should:be(YES)];
+	[expectThat(queue.pendingCount) should:be(0)];
+
+	[queue release];
+}
+
+- (void)itShouldSendRetriesBackThroughTheQueueThatDispatchedTheRequest {
+	RKRequestQueue* queue = [[RKRequestQueue alloc] init];
+	queue.maxConcurrentRequests = 1;
+	NSMutableArray* dispatchedRequests = [NSMutableArray array];
+	RKRequestQueueSpecRequest* requestA = [self requestWithURL:@"http://a.restkit.org/1" priority:RKRequestPriorityDefault dispatchedRequests:dispatchedRequests];
+	RKRequestQueueSpecRequest* requestB = [self requestWithURL:@"http://b.restkit.org/1" priority:RKRequestPriorityDefault dispatchedRequests:dispatchedRequests];
+	RKRequestRetryPolicy* policy = [RKRequestRetryPolicy defaultPolicy];
+	policy.initialBackoffInterval = 0.2;
+	policy.jitter = 0;
+	requestA.retryPolicy = policy;
+	[queue sendRequest:requestA];
+	[queue sendRequest:requestB];
+	[expectThat(requestA.queue == queue) should:be(YES)];
+
+	// The retrying request hands its slot to the next pending request while it waits
+	NSError* timeoutError = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorTimedOut userInfo:nil];
+	[expectThat([requestA retryAfterResponse:nil error:timeoutError]) should:be(YES)];
+	[expectThat([dispatchedRequests isEqualToArray:[NSArray arrayWithObjects:requestA, requestB, nil]]) should:be(YES)];
+	[expectThat(queue.loadingCount) should:be(1)];
+	[queue cancelRequest:requestB];
+	[expectThat(queue.loadingCount) should:be(0)];
+
+	// Once the delay has passed, it is sent again by the same queue
+	[[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+	[expectThat([dispatchedRequests isEqualToArray:[NSArray arrayWithObjects:requestA, requestB, requestA, nil]]) should:be(YES)];
+	[expectThat(queue.loadingCount) should:be(1)];
+
+	// Cancelling a request waiting to be retried keeps it from being sent again
+	[expectThat([requestA retryAfterResponse:nil error:timeoutError]) should:be(YES)];
+	[queue cancelRequest:requestA];
+	[[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.5]];
+	[expectThat([dispatchedRequests count]) should:be(3)];
+	[expectThat(queue.loadingCount) should:be(0)];
+	[expectThat(queue.pendingCount) should:be(0)];
+	[expectThat(requestA.queue == nil) should:be(YES)];
+
+	[queue release];
+}
+
+- (void)itShouldChooseHowToCompressTheBodyByItsSize {
+	RKRequest* request = [[[RKRequest alloc] initWithURL:[NSURL URLWithString:@"http://restkit.org/humans"]] autorelease];
+	request.method = RKRequestMethodPOST;
+	request.compressesBody = YES;
+	request.bodyCompressionThreshold = 1024;
+
+	// Small bodies are sent as they are
+	RKRequestSpecBody* smallBody = [[[RKRequestSpecBody alloc] initWithLength:512] autorelease];
+	request.params = smallBody;
+	[request prepareURLRequest];
+	[expectThat([[request.URLRequest HTTPBody] isEqualToData:[smallBody HTTPBody]]) should:be(YES)];
+	[expectThat([request.URLRequest valueForHTTPHeaderField:@"Content-Encoding"]) should:be(nil)];
+
+	// Bodies over the threshold are compressed up front and keep a Content-Length
+	RKRequestSpecBody* mediumBody = [[[RKRequestSpecBody alloc] initWithLength:16 * 1024] autorelease];
+	request.params = mediumBody;
+	[request prepareURLRequest];
+	NSData* compressedBody = [request.URLRequest HTTPBody];
+	[expectThat([compressedBody length] < [[mediumBody HTTPBody] length]) should:be(YES)];
+	[expectThat(((const uint8_t*)[compressedBody bytes])[0] == 0x1f && ((const uint8_t*)[compressedBody bytes])[1] == 0x8b) should:be(YES)];
+	[expectThat([request.URLRequest valueForHTTPHeaderField:@"Content-Encoding"]) should:be(@"gzip")];
+	NSString* contentLength = [NSString stringWithFormat:@"%lu", (unsigned long)[compressedBody length]];
+	[expectThat([request.URLRequest valueForHTTPHeaderField:@"Content-Length"]) should:be(contentLength)];
+
+	// Large bodies are compressed while they are sent, so their length is not known up front
+	request.params = [[[RKRequestSpecBody alloc] initWithLength:512 * 1024] autorelease];
+	[request prepareURLRequest];
+	[expectThat([request.URLRequest HTTPBody]) should:be(nil)];
+	[expectThat([[request.URLRequest HTTPBodyStream] isKindOfClass:[RKGzipInputStream class]]) should:be(YES)];
+	[expectThat([request.URLRequest valueForHTTPHeaderField:@"Content-Encoding"]) should:be(@"gzip")];
+	[expectThat([request.URLRequest valueForHTTPHeaderField:@"Content-Length"]) should:be(nil)];
+
+	// Preparing the request again without compression drops the headers of the compressed body
+	request.compressesBody = NO;
+	request.params = mediumBody;
+	[request prepareURLRequest];
+	[expectThat([[request.URLRequest HTTPBody] isEqualToData:[mediumBody HTTPBody]]) should:be(YES)];
+	[expectThat([request.URLRequest valueForHTTPHeaderField:@"Content-Encoding"]) should:be(nil)];
+	[expectThat([request.URLRequest valueForHTTPHeaderField:@"Content-Length"]) should:be(nil)];
+}
+
+- (void)itShouldGzipBodiesWhileTheyAreRead {
+	NSMutableString* JSON = [NSMutableString string];
+	int i;
+	for (i = 0; i < 5000; i++) {
+		[JSON appendFormat:@"{\"id\": %d, \"name\": \"Blake Watters\"},", i];
+	}
+	NSData* body = [JSON dataUsingEncoding:NSUTF8StringEncoding];
+
+	RKGzipInputStream* stream = [[RKGzipInputStream alloc] initWithInputStream:[NSInputStream inputStreamWithData:body]];
+	NSMutableData* compressedBody = [NSMutableData data];
+	uint8_t buffer[512];
+	NSInteger bytesRead;
+	[stream open];
+	while ((bytesRead = [stream read:buffer maxLength:sizeof(buffer)]) > 0) {
+		[compressedBody appendBytes:buffer length:bytesRead];
+	}
+	[expectThat([stream streamStatus]) should:be(NSStreamStatusAtEnd)];
+	[stream close];
+	[stream release];
+
+	// Inflating with 16 added to the window bits expects a gzip wrapper
+	NSMutableData* inflatedBody = [NSMutableData dataWithLength:[body length]];
+	z_stream zStream;
+	memset(&zStream, 0, sizeof(zStream));
+	inflateInit2(&zStream, MAX_WBITS + 16);
+	zStream.next_in = [compressedBody mutableBytes];
+	zStream.avail_in = [compressedBody length];
+	zStream.next_out = [inflatedBody mutableBytes];
+	zStream.avail_out = [inflatedBody length];
+	[expectThat(inflate(&zStream, Z_FINISH)) should:be(Z_STREAM_END)];
+	inflateEnd(&zStream);
+
+	[expectThat([compressedBody length] < [body length] / 10) should:be(YES)];
+	[expectThat([inflatedBody isEqualToData:body]) should:be(YES)];
+}
+
+- (void)itShouldStreamTheJSONSerializationOfLargeObjects {
+	NSMutableArray* humans = [NSMutableArray array];
+	int i;
+	for (i = 0; i < 2000; i++) {
+		[humans addObject:[NSDictionary dictionaryWithObjectsAndKeys:[NSNumber numberWithInt:i], @"id", @"Blake Watters", @"name", nil]];
+	}
+	RKJSONSerialization* serialization = [RKJSONSerialization JSONSerializationWithObject:[NSDictionary dictionaryWithObject:humans forKey:@"humans"]];
+	[expectThat([serialization HTTPBodyStream] == nil) should:be(YES)];
+
+	serialization.streamsLargeObjects = YES;
+	NSInputStream* stream = [serialization HTTPBodyStream];
+	[expectThat(stream != nil) should:be(YES)];
+
+	NSMutableData* body = [NSMutableData data];
+	uint8_t buffer[100];
+	NSInteger bytesRead;
+	[stream open];
+	while ((bytesRead = [stream read:buffer maxLength:sizeof(buffer)]) > 0) {
+		[body appendBytes:buffer length:bytesRead];
+	}
+	[stream close];
+	[expectThat([body isEqualToData:[serialization HTTPBody]]) should:be(YES)];
+
+	RKJSONSerialization* smallSerialization = [RKJSONSerialization JSONSerializationWithObject:[humans objectAtIndex:0]];
+	smallSerialization.streamsLargeObjects = YES;
+	[expectThat([smallSerialization HTTPBodyStream] == nil) should:be(YES)];
+}
+
+- (void)itShouldOnlyRetryIdempotentRequestsAfterTransientFailures {
+	RKRequestRetryPolicy* policy = [RKRequestRetryPolicy defaultPolicy];
+	RKRequest* request = [[[RKRequest alloc] initWithURL:[NSURL URLWithString:@"http://restkit.org"]] autorelease];
+	RKResponse* response = [[[RKResponse alloc] init] autorelease];
+	id mockResponse = [OCMockObject partialMockForObject:response];
+	NSInteger statusCode = 503;
+	[[[mockResponse stub] andReturnValue:OCMOCK_VALUE(statusCode)] statusCode];
+	NSError* timeoutError = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorTimedOut userInfo:nil];
+	NSError* badURLError = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorBadURL userInfo:nil];
+
+	[expectThat([policy shouldRetryRequest:request response:mockResponse error:nil]) should:be(YES)];
+	[expectThat([policy shouldRetryRequest:request response:nil error:timeoutError]) should:be(YES)];
+	[expectThat([policy shouldRetryRequest:request response:nil error:badURLError]) should:be(NO)];
+
+	request.method = RKRequestMethodPOST;
+	[expectThat([policy shouldRetryRequest:request response:mockResponse error:nil]) should:be(NO)];
+	[policy setRetriesMethod:YES forMethod:RKRequestMethodPOST];
+	[expectThat([policy shouldRetryRequest:request response:mockResponse error:nil]) should:be(YES)];
+}
+
+- (void)itShouldBackOffExponentiallyWithinTheJitter {
+	RKRequestRetryPolicy* policy = [RKRequestRetryPolicy defaultPolicy];
+	policy.initialBackoffInterval = 1;
+	policy.maximumBackoffInterval = 4;
+	NSUInteger attempt;
+	for (attempt = 1; attempt <= 4; attempt++) {
+		RKRequest* request = [[[RKRequest alloc] initWithURL:[NSURL URLWithString:@"http://restkit.org"]] autorelease];
+		id mockRequest = [OCMockObject partialMockForObject:request];
+		[[[mockRequest stub] andReturnValue:OCMOCK_VALUE(attempt)] attemptCount];
+		NSTimeInterval backoff = MIN(pow(2, attempt - 1), 4);
+		NSTimeInterval delay = [policy delayBeforeRetryingRequest:mockRequest response:nil];
+		[expectThat(delay >= backoff / 2 && delay <= backoff) should:be(YES)];
+	}
+}
+
+- (void)itShouldOnlyCollectMetricsForRequestsWithAMetricsSink {
+	RKRequest* request = [[[RKRequest alloc] initWithURL:[NSURL URLWithString:@"http://restkit.org"]] autorelease];
+	[[RKRequestQueue sharedQueue] setSuspended:YES];
+	[request send];
+	[expectThat(request.metrics == nil) should:be(YES)];
+	[[RKRequestQueue sharedQueue] cancelRequest:request];
+
+	id metricsSink = [OCMockObject niceMockForProtocol:@protocol(RKRequestMetricsSink)];
+	request.metricsSink = metricsSink;
+	[request send];
+	[expectThat(request.metrics != nil) should:be(YES)];
+	[expectThat(request.metrics.queuedTime > 0) should:be(YES)];
+	[[RKRequestQueue sharedQueue] cancelRequest:request];
+	[[RKRequestQueue sharedQueue] setSuspended:NO];
+}
+
+- (void)itShouldMeasureTheStagesOfARequest {
+	RKRequest* request = [[[RKRequest alloc] initWithURL:[NSURL URLWithString:@"http://restkit.org"]] autorelease];
+	RKRequestMetrics* metrics = [[[RKRequestMetrics alloc] initWithRequest:request] autorelease];
+	metrics.queuedTime = 100;
+	metrics.firstSentTime = 101;
+	metrics.sentTime = 102;
+	metrics.firstByteTime = 104;
+	[expectThat(metrics.queuedDuration) should:be(1.0)];
+	[expectThat(metrics.timeToFirstByte) should:be(2.0)];
+	[expectThat(metrics.downloadDuration) should:be(0.0)];
+	[expectThat(metrics.totalDuration) should:be(0.0)];
+
+	metrics.finishTime = 108;
+	metrics.completionTime = 110;
+	[expectThat(metrics.downloadDuration) should:be(4.0)];
+	[expectThat(metrics.totalDuration) should:be(10.0)];
+}
+
+- (RKRequestQueueSpecRequest*)requestWithURL:(NSString*)URLString priority:(RKRequestPriority)priority dispatchedRequests:(NSMutableArray*)dispatchedRequests {
+	RKRequestQueueSpecRequest* request = [[[RKRequestQueueSpecRequest alloc] initWithURL:[NSURL URLWithString:URLString]] autorelease];
+	request.priority = priority;
+	request.dispatchedRequests = dispatchedRequests;
+	return request;
+}
+
 @end
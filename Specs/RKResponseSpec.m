@@ -8,6 +8,9 @@
 
 #import "RKSpecEnvironment.h"
 #import "RKResponse.h"
+#import "RKResponseFileSink.h"
+#import "RKRequest.h"
+#import "Errors.h"
 
 @interface RKResponseSpec : NSObject <UISpec> {
 	RKResponse* _response;
@@ -191,4 +194,72 @@
 	[expectThat([mock isJSON]) should:be(YES)];
 }
 
+- (void)itShouldJoinBodyChunksWhenTheLengthIsUnknown {
+	RKResponse* response = [[[RKResponse alloc] init] autorelease];
+	[response connection:nil didReceiveData:[@"Hello, " dataUsingEncoding:NSUTF8StringEncoding]];
+	[response connection:nil didReceiveData:[@"World" dataUsingEncoding:NSUTF8StringEncoding]];
+	[expectThat([response bodyAsString]) should:be(@"Hello, World")];
+	[response connection:nil didReceiveData:[@"!" dataUsingEncoding:NSUTF8StringEncoding]];
+	[expectThat([response bodyAsString]) should:be(@"Hello, World!")];
+}
+
+- (void)itShouldWriteBodiesToAFileSinkAndMapThemBackIn {
+	RKResponseFileSink* sink = [RKResponseFileSink temporaryFileSink];
+	NSString* filePath = [[sink.filePath retain] autorelease];
+	[expectThat([sink writeData:[@"Hello, " dataUsingEncoding:NSUTF8StringEncoding]]) should:be(YES)];
+	[expectThat([sink writeData:[@"World" dataUsingEncoding:NSUTF8StringEncoding]]) should:be(YES)];
+	[sink finishWriting];
+	NSString* body = [[[NSString alloc] initWithData:[sink data] encoding:NSUTF8StringEncoding] autorelease];
+	[expectThat(body) should:be(@"Hello, World")];
+	[expectThat([[NSFileManager defaultManager] fileExistsAtPath:filePath]) should:be(YES)];
+}
+
+- (id)URLResponseWithStatusCode:(NSInteger)statusCode {
+	id URLResponse = [OCMockObject niceMockForClass:[NSHTTPURLResponse class]];
+	long long expectedContentLength = -1;
+	[[[URLResponse stub] andReturnValue:OCMOCK_VALUE(statusCode)] statusCode];
+	[[[URLResponse stub] andReturnValue:OCMOCK_VALUE(expectedContentLength)] expectedContentLength];
+	[[[URLResponse stub] andReturn:[NSDictionary dictionary]] allHeaderFields];
+	return URLResponse;
+}
+
+- (void)itShouldWriteOnlySuccessfulBodiesToTheSinkOfTheRequest {
+	NSData* data = [@"Hello, World" dataUsingEncoding:NSUTF8StringEncoding];
+	id sink = [OCMockObject niceMockForProtocol:@protocol(RKResponseBodySink)];
+	BOOL didWrite = YES;
+	[[[sink expect] andReturnValue:OCMOCK_VALUE(didWrite)] writeData:data];
+	RKRequest* request = [[[RKRequest alloc] initWithURL:[NSURL URLWithString:@"http://restkit.org"]] autorelease];
+	request.bodySink = sink;
+
+	RKResponse* response = [[[RKResponse alloc] initWithRequest:request] autorelease];
+	[response connection:nil didReceiveResponse:[self URLResponseWithStatusCode:200]];
+	[expectThat([response bodySink] == sink) should:be(YES)];
+	[response connection:nil didReceiveData:data];
+	[sink verify];
+
+	// Error bodies stay in memory, so the sink only ever sees what the caller asked for
+	RKResponse* errorResponse = [[[RKResponse alloc] initWithRequest:request] autorelease];
+	[errorResponse connection:nil didReceiveResponse:[self URLResponseWithStatusCode:404]];
+	[expectThat([errorResponse bodySink] == nil) should:be(YES)];
+	[errorResponse connection:nil didReceiveData:data];
+	[expectThat([errorResponse bodyAsString]) should:be(@"Hello, World")];
+}
+
+- (void)itShouldFailWithAnErrorWhenTheSinkDoesNotProvideOne {
+	id sink = [OCMockObject niceMockForProtocol:@protocol(RKResponseBodySink)];
+	BOOL didWrite = NO;
+	[[[sink stub] andReturnValue:OCMOCK_VALUE(didWrite)] writeData:OCMOCK_ANY];
+	RKRequest* request = [[[RKRequest alloc] initWithURL:[NSURL URLWithString:@"http://restkit.org"]] autorelease];
+	request.bodySink = sink;
+	id mockRequest = [OCMockObject partialMockForObject:request];
+	[[mockRequest expect] didFailLoadWithError:[OCMArg isNotNil]];
+
+	RKResponse* response = [[[RKResponse alloc] initWithRequest:mockRequest] autorelease];
+	[response connection:nil didReceiveResponse:[self URLResponseWithStatusCode:200]];
+	[response connection:nil didReceiveData:[@"Hello" dataUsingEncoding:NSUTF8StringEncoding]];
+	[mockRequest verify];
+	[expectThat([[response failureError] domain]) should:be(RKRestKitErrorDomain)];
+	[expectThat([[response failureError] code]) should:be(RKResponseBodySinkError)];
+}
+
 @end
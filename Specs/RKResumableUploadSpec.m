@@ -0,0 +1,95 @@
+//
+//  RKResumableUploadSpec.m
+//  RestKit
+//
+//  Created by RestKit contributors on 10/17/26.
+//  Copyright 2026 Two Toasters. All rights reserved.
+//
+
+#import "RKSpecEnvironment.h"
+#import "RKClient.h"
+#import "RKResumableUpload.h"
+
+@interface RKResumableUploadSpec : NSObject <UISpec, RKResumableUploadDelegate> {
+	BOOL _cancelsOnConfirmation;
+	BOOL _finished;
+}
+
+@end
+
+@implementation RKResumableUploadSpec
+
+- (void)upload:(RKResumableUpload*)upload didFinishWithResponse:(RKResponse*)response {
+	_finished = YES;
+}
+
+- (void)upload:(RKResumableUpload*)upload didFailWithError:(NSError*)error {
+	NSLog(@"Upload failed: %@", error);
+}
+
+- (void)upload:(RKResumableUpload*)upload didConfirmLength:(NSUInteger)confirmedLength ofLength:(NSUInteger)length {
+	if (_cancelsOnConfirmation) {
+		[upload cancel];
+	}
+}
+
+- (void)waitForUpload:(RKResumableUpload*)upload {
+	NSDate* startDate = [NSDate date];
+	while (upload.isUploading && [[NSDate date] timeIntervalSinceDate:startDate] < 30) {
+		[[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+	}
+}
+
+- (void)itShouldRemoveTheStateOfAbandonedUploads {
+	NSFileManager* fileManager = [NSFileManager defaultManager];
+	NSString* statePath = [RKResumableUpload defaultStatePath];
+	[fileManager createDirectoryAtPath:statePath withIntermediateDirectories:YES attributes:nil error:nil];
+	NSDictionary* state = [NSDictionary dictionaryWithObject:@"upload" forKey:@"uploadID"];
+	NSString* staleStatePath = [statePath stringByAppendingPathComponent:@"RKResumableUploadSpecStale.plist"];
+	NSString* recentStatePath = [statePath stringByAppendingPathComponent:@"RKResumableUploadSpecRecent.plist"];
+	[state writeToFile:staleStatePath atomically:YES];
+	[state writeToFile:recentStatePath atomically:YES];
+	NSDictionary* attributes = [NSDictionary dictionaryWithObject:[NSDate dateWithTimeIntervalSinceNow:-8 * 24 * 60 * 60] forKey:NSFileModificationDate];
+	[fileManager setAttributes:attributes ofItemAtPath:staleStatePath error:nil];
+
+	RKClient* client = [[[RKClient alloc] init] autorelease];
+	client.baseURL = @"http://restkit.org";
+	NSString* filePath = [[NSBundle mainBundle] pathForResource:@"blake" ofType:@"png"];
+	RKParamsAttachment* attachment = [[[RKParamsAttachment alloc] initWithName:@"file" file:filePath] autorelease];
+	[RKResumableUpload uploadWithResourcePath:@"/uploads" attachment:attachment client:client delegate:self];
+	[expectThat([fileManager fileExistsAtPath:staleStatePath]) should:be(NO)];
+	[expectThat([fileManager fileExistsAtPath:recentStatePath]) should:be(YES)];
+	[fileManager removeItemAtPath:recentStatePath error:nil];
+}
+
+/**
+ * This spec requires the test Sinatra server to be running
+ * `ruby Specs/server.rb`
+ */
+- (void)itShouldResumeAnInterruptedUploadFromTheConfirmedLength {
+	NSString* baseURL = [NSString stringWithFormat:@"http://%s:4567", getenv("RESTKIT_IP_ADDRESS")];
+	RKClient* client = [[[RKClient alloc] init] autorelease];
+	client.baseURL = baseURL;
+	NSString* filePath = [[NSBundle mainBundle] pathForResource:@"blake" ofType:@"png"];
+	RKParamsAttachment* attachment = [[[RKParamsAttachment alloc] initWithName:@"file" file:filePath] autorelease];
+
+	RKResumableUpload* upload = [RKResumableUpload uploadWithResourcePath:@"/uploads" attachment:attachment client:client delegate:self];
+	[upload discard];
+	upload.chunkSize = 1024;
+	_cancelsOnConfirmation = YES;
+	[upload send];
+	[self waitForUpload:upload];
+	[expectThat(upload.confirmedLength) should:be(1024)];
+
+	// A new upload of the same file picks up the persisted state
+	upload = [RKResumableUpload uploadWithResourcePath:@"/uploads" attachment:attachment client:client delegate:self];
+	[expectThat(upload.confirmedLength) should:be(1024)];
+	upload.chunkSize = 1024;
+	_cancelsOnConfirmation = NO;
+	[upload send];
+	[self waitForUpload:upload];
+	[expectThat(_finished) should:be(YES)];
+	[expectThat(upload.confirmedLength) should:be([[NSData dataWithContentsOfFile:filePath] length])];
+}
+
+@end
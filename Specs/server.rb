@@ -2,9 +2,49 @@ require 'rubygems'
 require 'sinatra'
 require 'json'
 require 'ruby-debug'
+require 'tmpdir'
+require 'fileutils'
 
 Debugger.start
 
+UPLOADS_PATH = File.join(Dir.tmpdir, 'restkit_uploads')
+FileUtils.mkdir_p(UPLOADS_PATH)
+
 post '/photo' do
   puts "Got request: #{request.body.read}"
 end
+
+# Stand-in for a resumable upload endpoint. Byte ranges of a file are PUT with a Content-Range
+# and an X-Upload-ID. Incomplete uploads are answered with a 308 and a Range naming the bytes stored
+put '/uploads' do
+  upload_id = request.env['HTTP_X_UPLOAD_ID']
+  halt 400 if upload_id.nil? || upload_id =~ /[^A-Za-z0-9\-]/
+  path = File.join(UPLOADS_PATH, upload_id)
+  stored = File.exist?(path) ? File.size(path) : 0
+
+  case request.env['HTTP_CONTENT_RANGE'].to_s
+  when /\Abytes \*\/(\d+)\z/
+    # A status query. Unknown uploads are reported as missing so the client starts over
+    total = $1.to_i
+    halt 404 unless File.exist?(path) || total == 0
+  when /\Abytes (\d+)-(\d+)\/(\d+)\z/
+    first, last, total = $1.to_i, $2.to_i, $3.to_i
+    halt 416 if first > stored
+    File.open(path, File.exist?(path) ? 'r+b' : 'wb') do |file|
+      file.seek(first)
+      file.write(request.body.read)
+    end
+    stored = [stored, last + 1].max
+  else
+    halt 400
+  end
+
+  if stored >= total
+    status 201
+    { :upload_id => upload_id, :length => stored }.to_json
+  else
+    status 308
+    headers 'Range' => "bytes=0-#{stored - 1}" if stored > 0
+    ''
+  end
+end
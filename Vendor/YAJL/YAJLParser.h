@@ -126,4 +126,14 @@ typedef NSUInteger YAJLParserStatus;
  */
 - (YAJLParserStatus)parse:(NSData *)data;
 
+/*!
+ Finish a streaming parse.
+ 
+ Call once all data has been passed to parse: to flush any
+ buffered trailing value and detect a truncated document.
+ 
+ @result See YAJLParserStatus
+ */
+- (YAJLParserStatus)parseCompleted;
+
 @end
@@ -53,6 +53,7 @@ NSString *const YAJLParserValueKey = @"YAJLParserValueKey";
 
 - (NSError *)_errorForStatus:(NSInteger)code message:(NSString *)message value:(NSString *)value;
 - (void)_cancelWithErrorForStatus:(NSInteger)code message:(NSString *)message value:(NSString *)value;
+- (YAJLParserStatus)_parserStatusForStatus:(rk_yajl_status)status data:(NSData *)data;
 @end
 
 
@@ -253,13 +254,23 @@ rk_yajl_end_array
   }
   
   rk_yajl_status status = rk_yajl_parse(handle_, [data bytes], [data length]);
+  return [self _parserStatusForStatus:status data:data];
+}
+
+- (YAJLParserStatus)parseCompleted {
+  if (!handle_) return YAJLParserStatusNone;
+  rk_yajl_status status = rk_yajl_parse_complete(handle_);
+  return [self _parserStatusForStatus:status data:nil];
+}
+
+- (YAJLParserStatus)_parserStatusForStatus:(rk_yajl_status)status data:(NSData *)data {
   if (status == rk_yajl_status_client_canceled) {
     // We cancelled because we encountered an error here in the client;
     // and parserError should be already set
     NSAssert(self.parserError, @"Client cancelled, but we have no parserError set");
     return YAJLParserStatusError;
   } else if (status == rk_yajl_status_error) {
-    unsigned char *errorMessage = rk_yajl_get_error(handle_, 1, [data bytes], [data length]);
+    unsigned char *errorMessage = rk_yajl_get_error(handle_, (data ? 1 : 0), [data bytes], [data length]);
     NSString *errorString = [NSString stringWithUTF8String:(char *)errorMessage];
     self.parserError = [self _errorForStatus:status message:errorString value:nil];
     rk_yajl_free_error(handle_, errorMessage);